@@ -0,0 +1,273 @@
+#include "number.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+using Sign = number::Sign;
+using Reduction = number::Reduction;
+
+using num_t = number::num_t;
+using exp_t = number::exp_t;
+
+using data_t = number::data_t;
+
+// Micro-benchmarks of the arithmetic over operand sizes from 1 chunk up, written to stdout as CSV with one row per
+// operation, shape, reduction policy and size
+//
+//     brno_number_bench [max_limbs [reduced_max_limbs [min_time_ms]]]
+//
+//     max_limbs            largest operand size in chunks measured without reduction, 1000000 by default
+//     reduced_max_limbs    largest operand size in chunks measured with the Always policy, whose gcds are quadratic,
+//                          1000 by default
+//     min_time_ms          time that every row repeats its operation for at least, 200 by default
+//
+//     Columns are the operation, the shape of the operands, the reduction policy, the size of the left operand in
+//     chunks, the number of iterations, nanoseconds per operation, allocations per operation, and chunks of the left
+//     operand processed per second
+
+
+
+//-ALLOCATION-COUNTING-------------------------------------------------------------------------------------------------
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if(void *const pointer = std::malloc(size ? size : 1))
+		return pointer;
+
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+
+
+//-OPERANDS------------------------------------------------------------------------------------------------------------
+
+enum class Shape {
+	// Nominator of the size over a denominator of one
+	Integer,
+	// Nominator and denominator of the size
+	Fraction,
+	// Nominator of the size over a denominator of one chunk
+	SmallDenominator
+};
+
+static const char *shapeName(Shape shape)
+{
+	switch(shape) {
+		case Shape::Integer:
+			return "integer";
+		case Shape::Fraction:
+			return "fraction";
+		case Shape::SmallDenominator:
+			return "small_den";
+	}
+
+	return "";
+}
+
+static std::mt19937_64 generator(20240229);
+
+// Random integer vector of size chunks, whose first and last chunks are non-zero
+static data_t randomVector(size_t size)
+{
+	data_t vec(size);
+
+	for(auto &chunk : vec)
+		chunk = num_t(generator());
+
+	vec.front() |= num_t(1) << (number::ChunkBits - 1);
+	vec.back() |= 1;
+
+	return vec;
+}
+
+// Random positive number of the shape, normalized when the policy reduces results
+static number randomNumber(Shape shape, size_t size, Reduction policy)
+{
+	const size_t denSize = shape == Shape::Integer ? 0 : shape == Shape::Fraction ? size : 1;
+
+	number result(Sign::Positive, exp_t(size), randomVector(size), exp_t(denSize),
+				  denSize ? randomVector(denSize) : data_t{1});
+
+	if(policy != Reduction::Never)
+		result.normalize();
+
+	return result;
+}
+
+
+
+//-MEASUREMENT---------------------------------------------------------------------------------------------------------
+
+enum class Operation {
+	Add,
+	Sub,
+	Multiply,
+	Divide,
+	Remainder,
+	Compare,
+	Power
+};
+
+static const char *operationName(Operation operation)
+{
+	switch(operation) {
+		case Operation::Add:
+			return "add";
+		case Operation::Sub:
+			return "sub";
+		case Operation::Multiply:
+			return "mul";
+		case Operation::Divide:
+			return "div";
+		case Operation::Remainder:
+			return "rem";
+		case Operation::Compare:
+			return "cmp";
+		case Operation::Power:
+			return "pow";
+	}
+
+	return "";
+}
+
+// Sizes of the results are summed here, so that the operations are not optimized away
+static volatile size_t sink = 0;
+
+static void run(Operation operation, number &result, const number &left, const number &right)
+{
+	switch(operation) {
+		case Operation::Add:
+			result = left + right;
+			break;
+		case Operation::Sub:
+			result = left - right;
+			break;
+		case Operation::Multiply:
+			result = left * right;
+			break;
+		case Operation::Divide:
+			result = left / right;
+			break;
+		case Operation::Remainder:
+			result = left % right;
+			break;
+		case Operation::Compare:
+			sink = sink + size_t(left < right);
+			return;
+		case Operation::Power:
+			result = number::Power(left, 3);
+			break;
+	}
+
+	sink = sink + result.nom().size();
+}
+
+static void measure(Operation operation, Shape shape, Reduction policy, size_t size, double minTime)
+{
+	using clock = std::chrono::steady_clock;
+
+	number::setReduction(policy);
+
+	// The remainder divides by an operand of half the size, where the division splits into balanced halves
+	const number
+			left = randomNumber(shape, size, policy),
+			right = randomNumber(shape, operation == Operation::Remainder ? (size + 1) / 2 : size, policy);
+
+	// One warm-up run lets the scratch memory grow to its steady state
+	number result;
+	run(operation, result, left, right);
+
+	size_t iterations = 0;
+	const size_t allocated = allocations.load(std::memory_order_relaxed);
+	const auto start = clock::now();
+	double elapsed = 0;
+
+	// Rounds of doubling length keep reading the clock out of the timings of the fast operations
+	for(size_t round = 1; elapsed < minTime; round *= 2) {
+		for(size_t index = 0; index < round; ++index)
+			run(operation, result, left, right);
+
+		iterations += round;
+		elapsed = std::chrono::duration<double>(clock::now() - start).count();
+	}
+
+	const size_t operationAllocations = allocations.load(std::memory_order_relaxed) - allocated;
+
+	std::printf("%s,%s,%s,%zu,%zu,%.1f,%.2f,%.4g\n",
+				operationName(operation), shapeName(shape), policy == Reduction::Never ? "never" : "always", size,
+				iterations, elapsed * 1e9 / double(iterations), double(operationAllocations) / double(iterations),
+				double(size) * double(iterations) / elapsed);
+	std::fflush(stdout);
+}
+
+
+
+//-MAIN----------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+	const size_t
+			maxSize = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 1000000,
+			reducedMaxSize = argc > 2 ? size_t(std::strtoull(argv[2], nullptr, 10)) : 1000,
+			minTimeMs = argc > 3 ? size_t(std::strtoull(argv[3], nullptr, 10)) : 200;
+
+	constexpr Operation Operations[] = {
+			Operation::Add, Operation::Sub, Operation::Multiply, Operation::Divide,
+			Operation::Remainder, Operation::Compare, Operation::Power
+	};
+	constexpr Shape Shapes[] = {Shape::Integer, Shape::Fraction, Shape::SmallDenominator};
+
+	std::printf("operation,shape,policy,limbs,iterations,ns_per_op,allocs_per_op,limbs_per_s\n");
+
+	// Sizes of 1 and 3 times the powers of ten
+	for(size_t decade = 1; decade <= maxSize; decade *= 10) {
+		for(const size_t size : {decade, 3 * decade}) {
+			if(size > maxSize)
+				continue;
+
+			for(const Shape shape : Shapes) {
+				for(const Operation operation : Operations) {
+					if(size <= reducedMaxSize)
+						measure(operation, shape, Reduction::Always, size, double(minTimeMs) / 1000);
+
+					measure(operation, shape, Reduction::Never, size, double(minTimeMs) / 1000);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
@@ -1,5 +1,14 @@
 #include "number.hpp"
 
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 
 
 //-TYPE-DEFINITIONS----------------------------------------------------------------------------------------------------
@@ -21,396 +30,3459 @@ using data_t = number::data_t;
 
 
 
-//-BUFFER-ARITHMETIC-FUNCTIONS-----------------------------------------------------------------------------------------
+//-SCRATCH-MEMORY------------------------------------------------------------------------------------------------------
+//    Temporary buffers of the computations are taken from a thread local stack of memory blocks, and are released in
+//    reverse order of their acquisition, so once the blocks have grown, a steady state of operations does not allocate
 
 
-// Computes a recursive addition over buffers left and right into dest, and returns overflow
-//     dest, left, right size >= count
-//     returns 0 or 1
+// Size of the blocks in bytes that the arena keeps after it is fully released, bigger ones are given back to the system
+static constexpr size_t ScratchRetainSize = size_t(1) << 24u;
 
-static result_t radd(num_t *__restrict dest,
-					 const num_t *__restrict left, const num_t *__restrict right, size_t count,
-					 result_t overflow = 0
-) noexcept
-{
-	do {
-		const result_t sum = result_t(*left--) + result_t(*right--) + overflow;
+class ScratchArena {
+	// Unit of the allocation, so that every buffer is suitably aligned
+	using unit_t = std::max_align_t;
 
-		overflow = sum & number::OverflowMask ? 1 : 0;
-		*dest-- = num_t(sum & number::ResultMask);
-	} while(--count);
+	static constexpr size_t MinBlockSize = (size_t(1) << 16u) / sizeof(unit_t);
 
-	return overflow;
-}
+	struct Block {
+		std::unique_ptr<unit_t[]> data;
+		size_t size;
+	};
 
+	std::vector<Block> m_blocks;
 
-// Computes a recursive subtraction over buffers left and right into dest, and returns overflow
-//     dest, left, right size >= count
-//     returns 0 or 1
+	// Top of the stack
+	size_t m_block = 0;
+	size_t m_used = 0;
 
-static sresult_t rsub(num_t *__restrict dest,
-					  const num_t *__restrict left, const num_t *__restrict right, size_t count,
-					  sresult_t overflow = 0
-) noexcept
-{
-	do {
-		const sresult_t sum = sresult_t(*left--) - sresult_t(*right--) - overflow;
-		const auto usum = result_t(sum);
+public:
+	struct Mark {
+		size_t block;
+		size_t used;
+	};
 
-		overflow = (usum & number::OverflowMask) ? 1 : 0;
-		*dest-- = num_t(usum & number::ResultMask);
-	} while(--count);
+	inline Mark mark() const noexcept { return {m_block, m_used}; }
 
-	return overflow;
-}
+	void release(Mark mark) noexcept
+	{
+		m_block = mark.block;
+		m_used = mark.used;
 
+		if(!m_block & !m_used) {
+			size_t retained = 0, count = 0;
 
-// Computes a recursive addition of buffers src and dest into dest itself, and returns overflow
-//     dest, src size >= count
-//     returns 0 or 1
+			while(count < m_blocks.size() && (retained += m_blocks[count].size * sizeof(unit_t)) <= ScratchRetainSize)
+				++count;
 
-static result_t rsum(num_t *__restrict dest,
-					 const num_t *__restrict src, size_t count,
-					 result_t overflow = 0
-) noexcept
-{
-	do {
-		const result_t sum = result_t(*dest) + result_t(*src--) + overflow;
+			m_blocks.resize(count);
+		}
+	}
 
-		overflow = sum & number::OverflowMask ? 1 : 0;
-		*dest-- = num_t(sum & number::ResultMask);
-	} while(--count);
+	template<typename T>
+	T *allocate(size_t count)
+	{
+		const size_t units = (count * sizeof(T) + sizeof(unit_t) - 1) / sizeof(unit_t);
 
-	return overflow;
-}
+		// Blocks that are too small for the request are skipped until the stack is released below them
+		while(m_block < m_blocks.size() && m_blocks[m_block].size - m_used < units) {
+			++m_block;
+			m_used = 0;
+		}
 
+		if(m_block == m_blocks.size()) {
+			const size_t size = std::max({units, MinBlockSize, m_blocks.empty() ? 0 : 2 * m_blocks.back().size});
 
-// Compute a recursive negative value of a buffer num over the size of count into the buffer itself
-//     num size >= count
+			m_blocks.push_back({std::unique_ptr<unit_t[]>(new unit_t[size]), size});
+		}
 
-static void rneg(num_t *__restrict num, size_t count,
-				 sresult_t overflow = 0
-) noexcept
+		T *const result = reinterpret_cast<T *>(m_blocks[m_block].data.get() + m_used);
+		m_used += units;
+
+		return result;
+	}
+};
+
+static thread_local ScratchArena scratchArena;
+
+
+// Uninitialized buffer of count values from the scratch arena, valid until the end of its scope
+template<typename T = num_t>
+class Scratch {
+	const ScratchArena::Mark m_mark;
+	T *const m_data;
+
+public:
+	explicit Scratch(size_t count) :
+			m_mark{scratchArena.mark()},
+			m_data{scratchArena.allocate<T>(count)} {}
+
+	Scratch(const Scratch &) = delete;
+	Scratch &operator=(const Scratch &) = delete;
+
+	~Scratch() { scratchArena.release(m_mark); }
+
+	inline T *data() const noexcept { return m_data; }
+	inline T &operator[](size_t index) const noexcept { return m_data[index]; }
+};
+
+
+// Vectors that the operations compute their results into before swapping them into the result
+//     The result gives its previous vectors in exchange, so repeated assignments to the same number keep reusing the
+//     same buffers, and results never alias the operands they are computed from
+struct SpareVectors {
+	data_t nom, den, leftNom, leftDen, rightNom, rightDen;
+};
+
+static thread_local SpareVectors spare;
+
+// Swaps a computed vector into place, spares that grew past the retained size are given back to the system
+static inline void swapIn(data_t &vec, data_t &computed)
 {
-	do {
-		const sresult_t sum = -sresult_t(*num) - overflow;
-		const auto usum = result_t(sum);
+	std::swap(vec, computed);
 
-		overflow = (usum & number::OverflowMask) ? 1 : 0;
-		*num-- = num_t(usum & number::ResultMask);
-	} while(--count);
+	if(computed.capacity() * sizeof(num_t) > ScratchRetainSize)
+		computed = data_t{};
 }
 
 
-// Compute a recursive multiplication of a buffer src by a number value into dest
-//     dest, src size >= count
 
-static num_t rmul(num_t *__restrict dest,
-				  const num_t *__restrict src, size_t count,
-				  const num_t value,
-				  result_t overflow = 0
-) noexcept
-{
-	const result_t r_value = value;
+//-THREAD-POOL---------------------------------------------------------------------------------------------------------
+//    Large multiplications fork their independent sub-products into lanes, that the workers of a shared pool run in
+//    parallel with the forking thread
+//    Every thread keeps a queue of the lanes it has forked, it runs the newest ones itself and workers steal the oldest
+//    ones from the others when they run out, lanes write to disjoint buffers, so results do not depend on their schedule
+//    A thread that waits for its fork runs only the lanes of that fork, the spare vectors and the scratch memory of the
+//    operation it is in the middle of belong to the lanes it runs too
 
-	do {
-		const result_t sum = result_t(*src--) * r_value + overflow;
 
-		overflow = sum >> number::OverflowOffset;
-		*dest-- = num_t(sum & number::ResultMask);
-	} while(--count);
+// Workers of the pool, by default one for every hardware thread besides the one that forks
+#ifndef BRNO_NUMBER_POOL_WORKERS
+#	define BRNO_NUMBER_POOL_WORKERS (std::max(std::thread::hardware_concurrency(), 1u) - 1)
+#endif
 
-	return num_t(overflow);
-}
+// Threads the operation of the calling thread may use, a worker takes the share of the lane it runs
+static thread_local size_t threadLimit = number::DefaultThreads;
 
+// Queue of the calling thread in the pool, threads outside of it share the last one
+static thread_local size_t poolQueue = std::numeric_limits<size_t>::max();
 
-// Compute a recursive multiplication of buffers bigger and smaller into dest
-//     biggerSize   >= smallerSize
-//     dest size    >= biggerSize + smallerSize + 1
-//     bigger size  >= biggerSize
-//     smaller size >= smallerSize
+class ThreadPool {
+public:
+	// Tasks first, first + step, ... of a fork, run in order by one thread
+	//     with the reduction policy and the precision of the forking thread
+	struct Lane {
+		void (*run)(const void *context, size_t first, size_t step);
+		const void *context;
+		size_t first, step, threads;
+		number::Reduction reduction;
+		size_t precision;
+		bool done;
+		std::exception_ptr error;
+	};
 
-static void rmul(num_t *__restrict dest,
-				 const num_t *__restrict bigger, size_t biggerSize,
-				 const num_t *__restrict smaller, size_t smallerSize
-) noexcept
-{
-	// Create a local buffer for partial multiplication
-	// TODO: Optimization is to avoid allocation in functions that call rmul recursively
-	const auto mulBufferSize = biggerSize + 1;
-	data_t multiplicationBuffer(mulBufferSize + 1, 0);
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_changed;
+	std::vector<std::deque<Lane *>> m_queues;
+	std::vector<std::thread> m_workers;
+	bool m_stopping = false;
 
-	num_t
-			&mulBufferOverflow = multiplicationBuffer[0],
-			*const mulBuffer = multiplicationBuffer.data() + biggerSize;
+	explicit ThreadPool(size_t workers) : m_queues(workers + 1)
+	{
+		// Workers wait for the mutex until all of them are started
+		const std::lock_guard<std::mutex> lock(m_mutex);
 
-	do {
-		mulBufferOverflow = rmul(mulBuffer, bigger, biggerSize, *smaller--);
-		*(dest - mulBufferSize) += num_t(rsum(dest, mulBuffer, mulBufferSize));
+		m_workers.reserve(workers);
 
-		--dest;
-	} while(--smallerSize);
-}
+		for(size_t index = 0; index < workers; ++index)
+			m_workers.emplace_back([this, index] { work(index); });
+	}
 
+public:
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
 
+	~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
 
-//-VECTOR-ARITHMETIC-FUNCTIONS-----------------------------------------------------------------------------------------
-//    These are the functions that operate on vectors and exponents, in abstraction they are between the number class
-//    and low level recursive computations that try to never allocate
-//    They mostly prepare buffers and handle control flow if the computation is more complex
+		m_changed.notify_all();
 
+		for(auto &worker : m_workers)
+			worker.join();
+	}
 
-// Basic vector operations
+	// Pool of BRNO_NUMBER_POOL_WORKERS workers, started by the first fork
+	static ThreadPool &instance()
+	{
+		static ThreadPool pool(BRNO_NUMBER_POOL_WORKERS);
+		return pool;
+	}
 
-static inline num_t *rptr(data_t &vec) noexcept { return vec.data() + vec.size() - 1; }
-static inline const num_t *rptr(const data_t &vec) noexcept { return vec.data() + vec.size() - 1; }
-static inline exp_t minExp(exp_t exp, const data_t &vec) noexcept { return exp - exp_t(vec.size()); }
+	// Threads that can run lanes, including the one that forks them
+	inline size_t size() const noexcept { return m_workers.size() + 1; }
 
-static inline exp_t pushFront(data_t &vec, num_t value, size_t count = 1)
-{
-	vec.insert(vec.begin(), count, value);
-	return exp_t(count);
-}
-static inline void pushBack(data_t &vec, num_t value, size_t count = 1) { vec.insert(vec.end(), count, value); }
+	void submit(Lane *lanes, size_t count)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			auto &queue = m_queues[std::min(poolQueue, m_workers.size())];
 
+			for(size_t index = 0; index < count; ++index)
+				queue.push_back(lanes + index);
+		}
 
-// Removes all trailing and leading zeros from the vector and returns the new exponent
-static exp_t truncate(exp_t exp, data_t &vec)
-{
-	const auto
-			front = std::find_if(vec.begin(), vec.end(), [](const auto &value) { return value; }),
-			back = std::find_if(vec.rbegin(), vec.rend(), [](const auto &value) { return value; }).base();
+		m_changed.notify_all();
+	}
 
-	// Vector is full of zeros
-	if(back <= front) {
-		vec.clear();
+	// Waits until the lanes are done, and runs the ones nobody has taken meanwhile, then rethrows the first error of
+	// the lanes
+	void join(Lane *lanes, size_t count)
+	{
+		const auto isDone = [lanes, count] {
+			return std::all_of(lanes, lanes + count, [](const Lane &lane) { return lane.done; });
+		};
 
-		return 0;
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while(!isDone()) {
+			if(Lane *const lane = take(lanes, count))
+				run(lock, *lane);
+			else
+				m_changed.wait(lock);
+		}
+
+		lock.unlock();
+
+		for(size_t index = 0; index < count; ++index)
+			if(lanes[index].error)
+				std::rethrow_exception(lanes[index].error);
 	}
-	else {
-		// Change in exponent is the number of leading zeros
-		const exp_t expChange = std::distance(vec.begin(), front);
 
-		// Move non-zero values to front and erase the rest
-		std::rotate(vec.begin(), front, back);
-		vec.resize(size_t(std::distance(front, back)));
+private:
+	void work(size_t index)
+	{
+		poolQueue = index;
 
-		return exp - expChange;
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while(!m_stopping) {
+			if(Lane *const lane = take())
+				run(lock, *lane);
+			else
+				m_changed.wait(lock);
+		}
 	}
-}
 
+	// Takes the newest lane of the calling thread, or steals the oldest one of another
+	//     expects the mutex locked
+	Lane *take() noexcept
+	{
+		const size_t own = std::min(poolQueue, m_workers.size());
+		Lane *lane = nullptr;
 
-// Turn an overflown two's-complement vector into a positive one
-static inline Sign turnNegative(data_t &vec) noexcept
-{
-	rneg(rptr(vec), vec.size());
-	return Sign::Negative;
-}
+		if(!m_queues[own].empty()) {
+			lane = m_queues[own].back();
+			m_queues[own].pop_back();
+		}
+		else {
+			for(size_t offset = 1; offset < m_queues.size() && !lane; ++offset) {
+				auto &queue = m_queues[(own + offset) % m_queues.size()];
 
+				if(!queue.empty()) {
+					lane = queue.front();
+					queue.pop_front();
+				}
+			}
+		}
 
-// Adds two vectors into result, and returns the final exponent
-static exp_t add(data_t &result,
-				 exp_t leftExp, data_t &&left,
-				 exp_t rightExp, data_t &&right)
-{
-	const exp_t
-			leftMinExp = minExp(leftExp, left),
-			rightMinExp = minExp(rightExp, right);
+		return lane;
+	}
 
-	// Determine correct boundaries
-	const bool
-			leftIsUpper = leftExp > rightExp,
-			leftIsLower = leftMinExp < rightMinExp;
+	// Takes the newest one of the lanes that is still in the queue of the calling thread, which they were submitted to
+	//     expects the mutex locked
+	Lane *take(Lane *lanes, size_t count) noexcept
+	{
+		auto &queue = m_queues[std::min(poolQueue, m_workers.size())];
 
-	data_t
-			&notUpper = leftIsUpper ? right : left,
-			&notLower = leftIsLower ? right : left;
+		const auto found = std::find_if(queue.rbegin(), queue.rend(), [lanes, count](Lane *lane) {
+			return !std::less<Lane *>()(lane, lanes) && std::less<Lane *>()(lane, lanes + count);
+		});
 
-	const exp_t
-			upperExp = leftIsUpper ? leftExp : rightExp,
-			notUpperExp = leftIsUpper ? rightExp : leftExp,
-			lowerMinExp = leftIsLower ? leftMinExp : rightMinExp,
-			notLowerMinExp = leftIsLower ? rightMinExp : leftMinExp;
+		if(found == queue.rend())
+			return nullptr;
 
-	// Prepare result
-	const auto size = size_t(upperExp - lowerMinExp);
-	result.clear();
-	result.resize(size);
+		Lane *const lane = *found;
+		queue.erase(std::next(found).base());
 
-	// Equalize number sizes
-	pushFront(notUpper, 0, size_t(upperExp - notUpperExp));
-	pushBack(notLower, 0, size_t(notLowerMinExp - lowerMinExp));
+		return lane;
+	}
 
-	exp_t expDelta = 0;
+	// Runs the lane with the mutex unlocked, and wakes the threads that wait for it
+	void run(std::unique_lock<std::mutex> &lock, Lane &lane)
+	{
+		lock.unlock();
 
-	// Sum and account for overflow
-	if(radd(rptr(result), rptr(left), rptr(right), size))
-		expDelta = pushFront(result, 1);
+		const size_t limit = std::exchange(threadLimit, lane.threads), precision = number::precision();
+		const number::Reduction reduction = number::reduction();
 
-	return truncate(upperExp + expDelta, result);
-}
+		number::setReduction(lane.reduction);
+		number::setPrecision(lane.precision);
 
+		try {
+			lane.run(lane.context, lane.first, lane.step);
+		}
+		catch(...) {
+			lane.error = std::current_exception();
+		}
 
-// Subtracts two vectors into result, and returns the final exponent and sign
-struct SubResult {
-	exp_t exp;
-	Sign sign;
+		threadLimit = limit;
+		number::setReduction(reduction);
+		number::setPrecision(precision);
+
+		lock.lock();
+		lane.done = true;
+
+		m_changed.notify_all();
+	}
 };
 
-static SubResult sub(data_t &result,
-					 exp_t leftExp, data_t &&left,
-					 exp_t rightExp, data_t &&right)
+
+// Runs tasks 0 to Count - 1, in parallel lanes if enabled and the thread limit allows it, and otherwise in order
+//     Threads of the limit are shared out between the lanes, so nested forks never exceed it
+
+template<size_t Count, typename Task>
+static void forkJoin(bool enabled, const Task &task)
 {
-	const exp_t
-			leftMinExp = minExp(leftExp, left),
-			rightMinExp = minExp(rightExp, right);
+	if(!enabled || threadLimit == 1) {
+		for(size_t index = 0; index < Count; ++index)
+			task(index);
 
-	// Determine correct boundaries
-	const bool
-			leftIsUpper = leftExp > rightExp,
-			leftIsLower = leftMinExp < rightMinExp;
+		return;
+	}
 
-	data_t
-			&notUpper = leftIsUpper ? right : left,
-			&notLower = leftIsLower ? right : left;
+	ThreadPool &pool = ThreadPool::instance();
 
-	const exp_t
-			upperExp = leftIsUpper ? leftExp : rightExp,
-			notUpperExp = leftIsUpper ? rightExp : leftExp,
-			lowerMinExp = leftIsLower ? leftMinExp : rightMinExp,
-			notLowerMinExp = leftIsLower ? rightMinExp : leftMinExp;
+	const size_t
+			threads = threadLimit ? std::min(threadLimit, pool.size()) : pool.size(),
+			count = std::min(threads, Count);
 
-	// Prepare result
-	const auto size = size_t(upperExp - lowerMinExp);
-	result.clear();
-	result.resize(size);
+	const auto run = [](const void *context, size_t first, size_t step) {
+		for(size_t index = first; index < Count; index += step)
+			(*static_cast<const Task *>(context))(index);
+	};
 
-	// Equalize number sizes
-	pushFront(notUpper, 0, size_t(upperExp - notUpperExp));
-	pushBack(notLower, 0, size_t(notLowerMinExp - lowerMinExp));
+	std::array<ThreadPool::Lane, Count> lanes;
 
-	// Sub and account for negative result on overflow
-	Sign sign = Sign::Positive;
+	for(size_t index = 0; index < count; ++index)
+		lanes[index] = {run, &task, index, count, threads / count + (index < threads % count ? 1 : 0),
+						number::reduction(), number::precision(), false, {}};
 
-	if(rsub(rptr(result), rptr(left), rptr(right), size))
-		sign = turnNegative(result);
+	pool.submit(lanes.data() + 1, count - 1);
 
-	return {
-			truncate(upperExp, result),
-			sign
-	};
+	// The forking thread runs the first lane, and the lanes nobody has taken meanwhile
+	const size_t limit = std::exchange(threadLimit, lanes[0].threads);
+
+	try {
+		run(&task, 0, count);
+	}
+	catch(...) {
+		threadLimit = limit;
+		pool.join(lanes.data() + 1, count - 1);
+		throw;
+	}
+
+	threadLimit = limit;
+	pool.join(lanes.data() + 1, count - 1);
 }
 
 
-// Multiplies two vectors into result, and returns the final exponent
-static exp_t multiply(data_t &result,
-					  exp_t leftExp, const data_t &left,
-					  exp_t rightExp, const data_t &right)
+
+//-CHUNK-ARITHMETIC-FUNCTIONS------------------------------------------------------------------------------------------
+
+
+// Counts the trailing zero bits of a non-zero chunk
+static inline digits_t trailingZeros(num_t value) noexcept
 {
-	const bool
-			leftIsBigger = left.size() > right.size();
+#if defined(__GNUC__)
+	return digits_t(__builtin_ctzll(value));
+#else
+	digits_t count = 0;
 
-	const data_t
-			&bigger = leftIsBigger ? left : right,
-			&smaller = leftIsBigger ? right : left;
+	for(; !(value & 1u); value >>= 1u)
+		++count;
 
-	const size_t
-			sizeChange = smaller.size() + 1,
-			size = bigger.size() + sizeChange;
+	return count;
+#endif
+}
 
-	result.clear();
-	result.resize(size);
 
-	rmul(rptr(result), rptr(bigger), bigger.size(), rptr(smaller), smaller.size());
+// Counts the leading zero bits of a non-zero chunk
+static inline digits_t leadingZeros(num_t value) noexcept
+{
+#if defined(__GNUC__)
+	return digits_t(__builtin_clzll(value)) - (64 - number::ChunkBits);
+#else
+	digits_t count = 0;
+
+	for(; !(value >> (number::ChunkBits - 1)); value <<= 1u)
+		++count;
 
-	return truncate(leftExp + rightExp + exp_t(sizeChange), result);
+	return count;
+#endif
 }
 
 
-// Squares a vector into result, and returns the final exponent
-static exp_t square(data_t &result,
-					exp_t numExp, const data_t &num)
+// Computes the greatest common divisor of two non-zero chunks
+static num_t gcd(num_t left, num_t right) noexcept
 {
-	const size_t
-			numSize = num.size(),
-			sizeChange = numSize + 1,
-			size = numSize + sizeChange;
+	const digits_t zeros = trailingZeros(left | right);
 
-	result.clear();
-	result.resize(size, 0);
+	left >>= trailingZeros(left);
 
-	rmul(rptr(result), rptr(num), numSize, rptr(num), numSize);
+	do {
+		right >>= trailingZeros(right);
+
+		if(left > right)
+			std::swap(left, right);
 
-	return truncate(numExp + numExp + exp_t(sizeChange), result);
+		right -= left;
+	} while(right);
+
+	return num_t(left << zeros);
 }
 
 
-// Computes a vector to power exp into result, and returns the final exponent
-static exp_t power(data_t &result, exp_t numExp, const data_t &num, uexp_t exp)
+// Computes the multiplicative inverse of an odd chunk modulo 2^ChunkBits
+static num_t inverse(num_t value) noexcept
 {
-	exp_t resultExp = 0;
+	// Every odd value is its own inverse modulo 8, each Newton step doubles the number of correct bits
+	num_t result = value;
 
-	// Intermediate square computation is double buffered between buffer[0] <-> buffer[1]
-	// Final result computation is double buffered between        buffer[2] <-> result
-	data_t
-			buffer[3] = {num, {}, {1}},
+	for(digits_t bits = 3; bits < number::ChunkBits; bits *= 2)
+		result = num_t(result * num_t(2u - value * result));
 
-			*oldValue = buffer,
-			*newValue = buffer + 1,
+	return result;
+}
 
-			*oldResult = buffer + 2,
-			*newResult = &result;
 
-	do {
-		// If the current power has the bit set, multiply the result by the current power value
-		// oldResult always keeps the current result, as they are swapped after every multiplication
-		if(exp & 1u) {
-			resultExp = multiply(*newResult, resultExp, *oldResult, numExp, *oldValue);
-			std::swap(oldResult, newResult);
+// Normalized divisor chunk with its reciprocal, which divides double chunks by multiplication
+//     Algorithm by Moller and Granlund, Improved division by invariant integers
+struct ChunkDivisor {
+	digits_t shift;
+	num_t div;
+	num_t reciprocal;
+
+	explicit ChunkDivisor(num_t divisor) noexcept :
+			shift{leadingZeros(divisor)},
+			div{num_t(divisor << shift)},
+			reciprocal{num_t(((result_t(num_t(~div)) << number::ChunkBits) | number::ResultMask) / div)} {}
+
+	// Divides high:low by the normalized divisor, and returns the quotient with the remainder left in high
+	//     high < div
+	inline num_t divide(num_t &high, num_t low) const noexcept
+	{
+		const result_t estimate = result_t(reciprocal) * high + ((result_t(high) + 1) << number::ChunkBits) + low;
+
+		auto quotient = num_t(estimate >> number::ChunkBits);
+		auto remainder = num_t(low - quotient * div);
+
+		if(remainder > num_t(estimate)) {
+			--quotient;
+			remainder = num_t(remainder + div);
+		}
+		if(remainder >= div) {
+			++quotient;
+			remainder = num_t(remainder - div);
 		}
 
-		// Square the current power value
-		// oldValue always keeps the current power value, as they are swapped after every multiplication
-		numExp = square(*newValue, numExp, *oldValue);
-		std::swap(oldValue, newValue);
+		high = remainder;
+		return quotient;
+	}
 
-		exp >>= 1u;
-	} while(exp);
+	// Chunk of a value scaled by the shift, from a chunk and the chunk below it
+	inline num_t scale(num_t value, num_t lower) const noexcept
+	{
+		return num_t(value << shift) | num_t((lower >> 1u) >> (number::ChunkBits - 1 - shift));
+	}
+};
 
-	// If the result of the computation is not in the output vector, move it there
-	if(oldResult != &result)
-		result = std::move(*oldResult);
 
-	return resultExp;
-}
 
+//-CARRY-CHAIN-KERNELS-------------------------------------------------------------------------------------------------
+//    x86-64 processors with the ADX and BMI2 extensions run the hot buffer loops in assembly, four chunks at a time,
+//    and the portable loops finish the chunks left over, or run alone where the extensions are missing
+//    Define BRNO_NUMBER_ADX as 0 to build only the portable loops
 
+#ifndef BRNO_NUMBER_ADX
+#	if BRNO_NUMBER_CHUNK_BITS == 64 && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#		define BRNO_NUMBER_ADX 1
+#	else
+#		define BRNO_NUMBER_ADX 0
+#	endif
+#endif
 
-//-NUMBER-ARITHMETIC-PRELIMINARY-CHECKS--------------------------------------------------------------------------------
-//    These functions Are run before the actual computation to do bound checking, and return true if they pass
-//    If they return false, they MUST set the result and that value will be returned
+#if BRNO_NUMBER_ADX
 
-static bool checkAdd(number &result, const number &left, const number &right)
-{
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+// Buffers of at least this many chunks go to the kernels
+static constexpr size_t AdxBlockSize = 4;
 
-	if(leftUndef | rightUndef)
-		result = number::Undefined();
-	else if(leftZero)
-		result = right;
-	else if(rightZero)
-		result = left;
-	else if(leftNan | rightNan)
-		result = number::NaN();
-	else
-		return true;
-	return false;
+static bool detectAdx() noexcept
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2");
+}
+
+// Selected once at startup, computations that run before it is set use the portable loops
+//     The kernel tests clear it to run the portable loops on the same inputs
+static bool HasAdx = detectAdx();
+
+
+// The kernels take pointers to the lowest chunks and a number of blocks of four chunks, and leave the pointers below
+// the blocks they have processed
+//     Offsets 24 to 0 address the chunks of a block from the least significant, the loops count with DEC and LEA that
+//     keep the carry flag, or with JRCXZ where the overflow flag carries too
+
+// Adds buffer src to dest with an incoming carry of 0 or 1, and returns the outgoing one
+static num_t adxsum(num_t *__restrict &dest, const num_t *__restrict &src,
+					size_t blocks, num_t carry) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *other = src - 3;
+
+	__asm__(
+			"bt $0, %[carry]\n\t"
+			"1:\n\t"
+			"mov 24(%[block]), %%r8\n\t"
+			"adc 24(%[other]), %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mov 16(%[block]), %%r8\n\t"
+			"adc 16(%[other]), %%r8\n\t"
+			"mov %%r8, 16(%[block])\n\t"
+			"mov 8(%[block]), %%r8\n\t"
+			"adc 8(%[other]), %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mov (%[block]), %%r8\n\t"
+			"adc (%[other]), %%r8\n\t"
+			"mov %%r8, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[other]), %[other]\n\t"
+			"dec %[blocks]\n\t"
+			"jnz 1b\n\t"
+			"mov $0, %k[carry]\n\t"
+			"adc $0, %[carry]\n\t"
+			: [carry] "+&r"(carry), [block] "+&r"(block), [other] "+&r"(other), [blocks] "+&r"(blocks)
+			:
+			: "r8", "cc", "memory");
+
+	dest = block + 3;
+	src = other + 3;
+	return carry;
+}
+
+// Subtracts buffer src from dest with an incoming borrow of 0 or 1, and returns the outgoing one
+static num_t adxdiff(num_t *__restrict &dest, const num_t *__restrict &src,
+					 size_t blocks, num_t borrow) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *other = src - 3;
+
+	__asm__(
+			"bt $0, %[borrow]\n\t"
+			"1:\n\t"
+			"mov 24(%[block]), %%r8\n\t"
+			"sbb 24(%[other]), %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mov 16(%[block]), %%r8\n\t"
+			"sbb 16(%[other]), %%r8\n\t"
+			"mov %%r8, 16(%[block])\n\t"
+			"mov 8(%[block]), %%r8\n\t"
+			"sbb 8(%[other]), %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mov (%[block]), %%r8\n\t"
+			"sbb (%[other]), %%r8\n\t"
+			"mov %%r8, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[other]), %[other]\n\t"
+			"dec %[blocks]\n\t"
+			"jnz 1b\n\t"
+			"mov $0, %k[borrow]\n\t"
+			"adc $0, %[borrow]\n\t"
+			: [borrow] "+&r"(borrow), [block] "+&r"(block), [other] "+&r"(other), [blocks] "+&r"(blocks)
+			:
+			: "r8", "cc", "memory");
+
+	dest = block + 3;
+	src = other + 3;
+	return borrow;
+}
+
+// Subtracts buffer right from left into dest with an incoming borrow of 0 or 1, and returns the outgoing one
+static num_t adxsub(num_t *__restrict &dest, const num_t *__restrict &left, const num_t *__restrict &right,
+					size_t blocks, num_t borrow) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *minuend = left - 3, *subtrahend = right - 3;
+
+	__asm__(
+			"bt $0, %[borrow]\n\t"
+			"1:\n\t"
+			"mov 24(%[minuend]), %%r8\n\t"
+			"sbb 24(%[subtrahend]), %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mov 16(%[minuend]), %%r8\n\t"
+			"sbb 16(%[subtrahend]), %%r8\n\t"
+			"mov %%r8, 16(%[block])\n\t"
+			"mov 8(%[minuend]), %%r8\n\t"
+			"sbb 8(%[subtrahend]), %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mov (%[minuend]), %%r8\n\t"
+			"sbb (%[subtrahend]), %%r8\n\t"
+			"mov %%r8, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[minuend]), %[minuend]\n\t"
+			"lea -32(%[subtrahend]), %[subtrahend]\n\t"
+			"dec %[blocks]\n\t"
+			"jnz 1b\n\t"
+			"mov $0, %k[borrow]\n\t"
+			"adc $0, %[borrow]\n\t"
+			: [borrow] "+&r"(borrow), [block] "+&r"(block), [minuend] "+&r"(minuend), [subtrahend] "+&r"(subtrahend),
+			  [blocks] "+&r"(blocks)
+			:
+			: "r8", "cc", "memory");
+
+	dest = block + 3;
+	left = minuend + 3;
+	right = subtrahend + 3;
+	return borrow;
+}
+
+// Multiplies buffer src by value into dest with an incoming carry chunk, and returns the outgoing one
+//     The high half of each product is carried into the low half of the next one
+static num_t adxmul(num_t *__restrict &dest, const num_t *__restrict &src,
+					size_t blocks, num_t value, num_t carry) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *other = src - 3;
+
+	__asm__(
+			"xor %%r8d, %%r8d\n\t"
+			"1:\n\t"
+			"mulx 24(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mulx 16(%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"mov %%r10, 16(%[block])\n\t"
+			"mulx 8(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mulx (%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"mov %%r10, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[other]), %[other]\n\t"
+			"dec %[blocks]\n\t"
+			"jnz 1b\n\t"
+			"mov $0, %%r8d\n\t"
+			"adcx %%r8, %[carry]\n\t"
+			: [carry] "+&r"(carry), [block] "+&r"(block), [other] "+&r"(other), [blocks] "+&r"(blocks)
+			: "d"(value)
+			: "r8", "r9", "r10", "cc", "memory");
+
+	dest = block + 3;
+	src = other + 3;
+	return carry;
+}
+
+// Adds buffer src multiplied by value to dest with an incoming carry chunk, and returns the outgoing one
+//     ADCX carries the high half of each product into the next one, while ADOX adds the chunks of dest
+static num_t adxmuladd(num_t *__restrict &dest, const num_t *__restrict &src,
+					   size_t blocks, num_t value, num_t carry) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *other = src - 3;
+
+	__asm__(
+			"xor %%r8d, %%r8d\n\t"
+			"1:\n\t"
+			"mulx 24(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"adox 24(%[block]), %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mulx 16(%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"adox 16(%[block]), %%r10\n\t"
+			"mov %%r10, 16(%[block])\n\t"
+			"mulx 8(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"adox 8(%[block]), %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mulx (%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"adox (%[block]), %%r10\n\t"
+			"mov %%r10, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[other]), %[other]\n\t"
+			"lea -1(%[blocks]), %[blocks]\n\t"
+			"jrcxz 2f\n\t"
+			"jmp 1b\n\t"
+			"2:\n\t"
+			"mov $0, %%r8d\n\t"
+			"adcx %%r8, %[carry]\n\t"
+			"adox %%r8, %[carry]\n\t"
+			: [carry] "+&r"(carry), [block] "+&r"(block), [other] "+&r"(other), [blocks] "+&c"(blocks)
+			: "d"(value)
+			: "r8", "r9", "r10", "cc", "memory");
+
+	dest = block + 3;
+	src = other + 3;
+	return carry;
+}
+
+// Subtracts buffer src multiplied by value from dest with an incoming carry chunk, and returns the outgoing one
+//     ADOX adds the complements of the products with a carry that starts set, which subtracts them, and a clear
+//     overflow flag at the end is a borrow
+static result_t adxsubmul(num_t *__restrict &dest, const num_t *__restrict &src,
+						  size_t blocks, num_t value, num_t carry) noexcept
+{
+	num_t *block = dest - 3;
+	const num_t *other = src - 3;
+	unsigned char noBorrow;
+
+	__asm__(
+			"mov $0x7fffffffffffffff, %%r8\n\t"
+			"add $1, %%r8\n\t"
+			"1:\n\t"
+			"mulx 24(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"not %%r8\n\t"
+			"adox 24(%[block]), %%r8\n\t"
+			"mov %%r8, 24(%[block])\n\t"
+			"mulx 16(%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"not %%r10\n\t"
+			"adox 16(%[block]), %%r10\n\t"
+			"mov %%r10, 16(%[block])\n\t"
+			"mulx 8(%[other]), %%r8, %%r9\n\t"
+			"adcx %[carry], %%r8\n\t"
+			"not %%r8\n\t"
+			"adox 8(%[block]), %%r8\n\t"
+			"mov %%r8, 8(%[block])\n\t"
+			"mulx (%[other]), %%r10, %[carry]\n\t"
+			"adcx %%r9, %%r10\n\t"
+			"not %%r10\n\t"
+			"adox (%[block]), %%r10\n\t"
+			"mov %%r10, (%[block])\n\t"
+			"lea -32(%[block]), %[block]\n\t"
+			"lea -32(%[other]), %[other]\n\t"
+			"lea -1(%[blocks]), %[blocks]\n\t"
+			"jrcxz 2f\n\t"
+			"jmp 1b\n\t"
+			"2:\n\t"
+			"mov $0, %%r8d\n\t"
+			"adcx %%r8, %[carry]\n\t"
+			"seto %[noBorrow]\n\t"
+			: [carry] "+&r"(carry), [block] "+&r"(block), [other] "+&r"(other), [blocks] "+&c"(blocks),
+			  [noBorrow] "=&r"(noBorrow)
+			: "d"(value)
+			: "r8", "r9", "r10", "cc", "memory");
+
+	dest = block + 3;
+	src = other + 3;
+	return result_t(carry) + !noBorrow;
+}
+
+#endif
+
+
+
+//-BUFFER-ARITHMETIC-FUNCTIONS-----------------------------------------------------------------------------------------
+
+
+// Computes a recursive subtraction over buffers left and right into dest, and returns overflow
+//     dest, left, right size >= count
+//     returns 0 or 1
+
+static sresult_t rsub(num_t *__restrict dest,
+					  const num_t *__restrict left, const num_t *__restrict right, size_t count,
+					  sresult_t overflow = 0
+) noexcept
+{
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = sresult_t(adxsub(dest, left, right, count / AdxBlockSize, num_t(overflow)));
+
+		if(!(count %= AdxBlockSize))
+			return overflow;
+	}
+#endif
+
+	do {
+		const sresult_t sum = sresult_t(*left--) - sresult_t(*right--) - overflow;
+		const auto usum = result_t(sum);
+
+		overflow = (usum & number::OverflowMask) ? 1 : 0;
+		*dest-- = num_t(usum & number::ResultMask);
+	} while(--count);
+
+	return overflow;
+}
+
+
+// Computes a recursive addition of buffers src and dest into dest itself, and returns overflow
+//     dest, src size >= count
+//     returns 0 or 1
+
+static result_t rsum(num_t *__restrict dest,
+					 const num_t *__restrict src, size_t count,
+					 result_t overflow = 0
+) noexcept
+{
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = adxsum(dest, src, count / AdxBlockSize, num_t(overflow));
+
+		if(!(count %= AdxBlockSize))
+			return overflow;
+	}
+#endif
+
+	do {
+		const result_t sum = result_t(*dest) + result_t(*src--) + overflow;
+
+		overflow = sum & number::OverflowMask ? 1 : 0;
+		*dest-- = num_t(sum & number::ResultMask);
+	} while(--count);
+
+	return overflow;
+}
+
+
+// Compute a recursive negative value of a buffer num over the size of count into the buffer itself
+//     num size >= count
+
+static void rneg(num_t *__restrict num, size_t count,
+				 sresult_t overflow = 0
+) noexcept
+{
+	do {
+		const sresult_t sum = -sresult_t(*num) - overflow;
+		const auto usum = result_t(sum);
+
+		overflow = (usum & number::OverflowMask) ? 1 : 0;
+		*num-- = num_t(usum & number::ResultMask);
+	} while(--count);
+}
+
+
+// Compute a recursive multiplication of a buffer src by a number value into dest
+//     dest, src size >= count
+
+static num_t rmul(num_t *__restrict dest,
+				  const num_t *__restrict src, size_t count,
+				  const num_t value,
+				  result_t overflow = 0
+) noexcept
+{
+	const result_t r_value = value;
+
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = adxmul(dest, src, count / AdxBlockSize, value, num_t(overflow));
+
+		if(!(count %= AdxBlockSize))
+			return num_t(overflow);
+	}
+#endif
+
+	do {
+		const result_t sum = result_t(*src--) * r_value + overflow;
+
+		overflow = sum >> number::OverflowOffset;
+		*dest-- = num_t(sum & number::ResultMask);
+	} while(--count);
+
+	return num_t(overflow);
+}
+
+
+// Compute a recursive multiplication of a buffer src by a number value added to dest, and returns overflow
+//     dest, src size >= count
+
+static num_t rmuladd(num_t *__restrict dest,
+					 const num_t *__restrict src, size_t count,
+					 const num_t value,
+					 result_t overflow = 0
+) noexcept
+{
+	const result_t r_value = value;
+
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = adxmuladd(dest, src, count / AdxBlockSize, value, num_t(overflow));
+
+		if(!(count %= AdxBlockSize))
+			return num_t(overflow);
+	}
+#endif
+
+	do {
+		const result_t sum = result_t(*src--) * r_value + result_t(*dest) + overflow;
+
+		overflow = sum >> number::OverflowOffset;
+		*dest-- = num_t(sum & number::ResultMask);
+	} while(--count);
+
+	return num_t(overflow);
+}
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest
+//     biggerSize   >= smallerSize
+//     dest size    >= biggerSize + smallerSize
+//     bigger size  >= biggerSize
+//     smaller size >= smallerSize
+
+static void rmul(num_t *__restrict dest,
+				 const num_t *__restrict bigger, size_t biggerSize,
+				 const num_t *__restrict smaller, size_t smallerSize
+) noexcept
+{
+	*(dest - biggerSize) = rmul(dest, bigger, biggerSize, *smaller--);
+
+	while(--smallerSize) {
+		--dest;
+		*(dest - biggerSize) = rmuladd(dest, bigger, biggerSize, *smaller--);
+	}
+}
+
+
+// Computes a recursive subtraction of buffer src from dest into dest itself, and returns overflow
+//     dest, src size >= count
+//     returns 0 or 1
+
+static sresult_t rdiff(num_t *__restrict dest,
+					   const num_t *__restrict src, size_t count,
+					   sresult_t overflow = 0
+) noexcept
+{
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = sresult_t(adxdiff(dest, src, count / AdxBlockSize, num_t(overflow)));
+
+		if(!(count %= AdxBlockSize))
+			return overflow;
+	}
+#endif
+
+	do {
+		const sresult_t sum = sresult_t(*dest) - sresult_t(*src--) - overflow;
+		const auto usum = result_t(sum);
+
+		overflow = (usum & number::OverflowMask) ? 1 : 0;
+		*dest-- = num_t(usum & number::ResultMask);
+	} while(--count);
+
+	return overflow;
+}
+
+
+// Compute a recursive subtraction of a buffer src multiplied by a number value from dest, and returns overflow
+//     dest, src size >= count
+
+static num_t rsubmul(num_t *__restrict dest,
+					 const num_t *__restrict src, size_t count,
+					 const num_t value,
+					 result_t overflow = 0
+) noexcept
+{
+	const result_t r_value = value;
+
+#if BRNO_NUMBER_ADX
+	if(count >= AdxBlockSize && HasAdx) {
+		overflow = adxsubmul(dest, src, count / AdxBlockSize, value, num_t(overflow));
+
+		if(!(count %= AdxBlockSize))
+			return num_t(overflow);
+	}
+#endif
+
+	do {
+		const result_t product = result_t(*src--) * r_value + overflow;
+		const auto low = num_t(product & number::ResultMask);
+
+		overflow = (product >> number::OverflowOffset) + (*dest < low ? 1 : 0);
+		*dest = num_t(*dest - low);
+		--dest;
+	} while(--count);
+
+	return num_t(overflow);
+}
+
+
+// Propagates a borrow through the buffer num, until it is absorbed
+//     num size >= count
+
+static void rborrow(num_t *__restrict num, size_t count, num_t borrow) noexcept
+{
+	while(borrow && count--) {
+		const num_t value = *num;
+
+		*num-- = num_t(value - borrow);
+		borrow = value < borrow ? 1 : 0;
+	}
+}
+
+
+// Compares buffers left and right of the same size, and returns their order
+//     left, right size >= count
+//     returns -1, 0 or 1
+
+static int rcmp(const num_t *__restrict left, const num_t *__restrict right, size_t count) noexcept
+{
+	left -= count - 1;
+	right -= count - 1;
+
+	do {
+		if(*left != *right)
+			return *left < *right ? -1 : 1;
+
+		++left;
+		++right;
+	} while(--count);
+
+	return 0;
+}
+
+
+// Shifts a buffer num right by shift bits in place
+//     num size >= count
+//     0 < shift < ChunkBits
+
+static void rshr(num_t *__restrict num, size_t count, digits_t shift) noexcept
+{
+	num_t overflow = 0;
+	num -= count - 1;
+
+	do {
+		const num_t value = *num;
+
+		*num++ = num_t(value >> shift) | overflow;
+		overflow = num_t(value << (number::ChunkBits - shift));
+	} while(--count);
+}
+
+
+// Shifts a buffer num left by shift bits in place, and returns the bits shifted out
+//     num size >= count
+//     0 < shift < ChunkBits
+
+static num_t rshl(num_t *__restrict num, size_t count, digits_t shift) noexcept
+{
+	num_t overflow = 0;
+
+	do {
+		const num_t value = *num;
+
+		*num-- = num_t(value << shift) | overflow;
+		overflow = num_t(value >> (number::ChunkBits - shift));
+	} while(--count);
+
+	return overflow;
+}
+
+
+// Computes the remainder of a buffer num divided by a chunk div
+//     num size >= count
+//     div > 0
+
+static num_t rmod(const num_t *num, size_t count, num_t div) noexcept
+{
+	const ChunkDivisor divisor(div);
+	num -= count - 1;
+
+	// The value is scaled along with the divisor, which scales only the remainder
+	num_t remainder = divisor.scale(0, *num);
+
+	do {
+		const num_t value = *num++;
+
+		divisor.divide(remainder, divisor.scale(value, count > 1 ? *num : 0));
+	} while(--count);
+
+	return num_t(remainder >> divisor.shift);
+}
+
+
+// Computes a division of a buffer num by a chunk div into dest, and returns the remainder
+//     dest, num size >= count, dest can be num itself
+//     div > 0
+
+static num_t rdiv(num_t *dest, const num_t *num, size_t count, num_t div) noexcept
+{
+	const ChunkDivisor divisor(div);
+	dest -= count - 1;
+	num -= count - 1;
+
+	// The value is scaled along with the divisor, which scales only the remainder
+	num_t remainder = divisor.scale(0, *num);
+
+	do {
+		const num_t value = *num++;
+
+		*dest++ = divisor.divide(remainder, divisor.scale(value, count > 1 ? *num : 0));
+	} while(--count);
+
+	return num_t(remainder >> divisor.shift);
+}
+
+
+// Compute a recursive schoolbook division (Knuth's algorithm D) of a buffer num by a normalized buffer div, with the
+// quotient into dest and the remainder left in the lowest divSize chunks of num
+//     the top chunk of div has its highest bit set, divSize >= 2
+//     num size  >= count + divSize, where the top divSize chunks of num are below div
+//     dest size >= count
+
+static void rdivrem(num_t *__restrict dest,
+					num_t *__restrict num, size_t count,
+					const num_t *__restrict div, size_t divSize
+) noexcept
+{
+	const result_t
+			high = *(div - (divSize - 1)),
+			next = *(div - (divSize - 2));
+
+	num_t *const top = num - (count + divSize - 1);
+	dest -= count - 1;
+
+	for(size_t index = 0; index < count; ++index) {
+		num_t *const window = top + index;
+
+		// Estimate from the top chunks is at most two above the quotient chunk, and the next chunk of div mostly
+		// corrects it
+		const result_t value = (result_t(window[0]) << number::ChunkBits) | window[1];
+
+		result_t
+				estimate = value / high,
+				rest = value % high;
+
+		while(estimate > number::ResultMask || estimate * next > ((rest << number::ChunkBits) | window[2])) {
+			--estimate;
+			rest += high;
+
+			if(rest > number::ResultMask)
+				break;
+		}
+
+		auto quotient = num_t(estimate);
+
+		// The estimate is now at most one above, which makes the remainder negative
+		if(rsubmul(window + divSize, div, divSize, quotient) > window[0]) {
+			rsum(window + divSize, div, divSize);
+			--quotient;
+		}
+
+		window[0] = 0;
+		dest[index] = quotient;
+	}
+}
+
+
+// Compute a recursive exact division of a buffer num by an odd buffer div into dest
+//     div must divide the value of num, only the lowest count chunks of num are read, and they are destroyed
+//     dest, num size >= count, where count is the size of the quotient
+//     div size       >= divSize
+//     inverse is the inverse of the lowest chunk of div modulo 2^ChunkBits
+
+static void rdivexact(num_t *__restrict dest,
+					  num_t *__restrict num, size_t count,
+					  const num_t *__restrict div, size_t divSize,
+					  const num_t inverse
+) noexcept
+{
+	do {
+		// The lowest chunk of the remainder determines the next chunk of the quotient
+		const auto quotient = num_t(*num * inverse);
+		const size_t size = std::min(divSize, count);
+
+		rborrow(num - size, count - size, rsubmul(num, div, size, quotient));
+
+		*dest-- = quotient;
+		--num;
+	} while(--count);
+}
+
+
+// Compute a recursive square of a buffer num into dest
+//     dest size >= 2 * count
+//     num size  >= count
+
+static void rsqr(num_t *__restrict dest,
+				 const num_t *__restrict num, size_t count
+) noexcept
+{
+	const size_t size = 2 * count;
+
+	*dest = 0;
+	*(dest - (size - 1)) = 0;
+
+	// Products of distinct chunks appear twice in the square, so they are computed once and doubled
+	if(count > 1) {
+		*(dest - count) = rmul(dest - 1, num - 1, count - 1, *num);
+
+		for(size_t index = 1; index < count - 1; ++index)
+			*(dest - count - index) = rmuladd(dest - 2 * index - 1, num - index - 1, count - index - 1, *(num - index));
+
+		rshl(dest, size, 1);
+	}
+
+	// Squares of the chunks lie on the diagonal
+	result_t overflow = 0;
+
+	for(size_t index = 0; index < count; ++index) {
+		const result_t
+				value = *(num - index),
+				product = value * value,
+				low = result_t(*(dest - 2 * index)) + (product & number::ResultMask) + overflow,
+				high = result_t(*(dest - 2 * index - 1)) + (product >> number::OverflowOffset) + (low >> number::OverflowOffset);
+
+		*(dest - 2 * index) = num_t(low & number::ResultMask);
+		*(dest - 2 * index - 1) = num_t(high & number::ResultMask);
+		overflow = high >> number::OverflowOffset;
+	}
+}
+
+
+
+//-WORD-ARITHMETIC-FUNCTIONS-------------------------------------------------------------------------------------------
+//    Fractions with a single chunk nominator and denominator are computed with native arithmetic on their chunks
+//    The functions return false when the result does not fit in single chunks, and the operation falls back to vectors
+
+
+// Fraction of coprime chunks, zero has a zero nominator
+struct Word {
+	num_t nom, den;
+};
+
+// Cancels the factors of common that nom shares with the denominator, which can share no other factors with it
+static bool reduceWord(Word &result, result_t nom, result_t den, num_t common) noexcept
+{
+	if(nom) {
+		const auto remainder = num_t(nom % common);
+		const num_t factor = remainder ? gcd(remainder, common) : common;
+
+		nom /= factor;
+		den /= factor;
+	}
+	else
+		den = 1;
+
+	if((nom | den) & number::OverflowMask)
+		return false;
+
+	result = {num_t(nom), num_t(den)};
+	return true;
+}
+
+// Rewrites left and right over their common denominator, and returns the gcd of the denominators
+static num_t commonWords(result_t &leftNom, result_t &rightNom, result_t &den, Word left, Word right) noexcept
+{
+	const num_t common = gcd(left.den, right.den);
+
+	leftNom = result_t(left.nom) * (right.den / common);
+	rightNom = result_t(right.nom) * (left.den / common);
+	den = result_t(left.den / common) * right.den;
+
+	return common;
+}
+
+static bool addWords(Word &result, Word left, Word right) noexcept
+{
+	result_t leftNom, rightNom, den;
+	const num_t common = commonWords(leftNom, rightNom, den, left, right);
+
+	// The sum can overflow the double chunk
+	if(leftNom > std::numeric_limits<result_t>::max() - rightNom)
+		return false;
+
+	return reduceWord(result, leftNom + rightNom, den, common);
+}
+
+// Subtracts the magnitudes of right from left, the sign of the difference is returned through sign
+static bool subWords(Word &result, Sign &sign, Word left, Word right) noexcept
+{
+	result_t leftNom, rightNom, den;
+	const num_t common = commonWords(leftNom, rightNom, den, left, right);
+
+	sign = Sign(leftNom >= rightNom);
+
+	return reduceWord(result, sign == Sign::Positive ? leftNom - rightNom : rightNom - leftNom, den, common);
+}
+
+static bool multiplyWords(Word &result, Word left, Word right) noexcept
+{
+	// Coprime operands can share factors only across the fractions
+	const num_t
+			nomDen = gcd(left.nom, right.den),
+			denNom = gcd(left.den, right.nom);
+
+	const result_t
+			nom = result_t(left.nom / nomDen) * (right.nom / denNom),
+			den = result_t(left.den / denNom) * (right.den / nomDen);
+
+	if((nom | den) & number::OverflowMask)
+		return false;
+
+	result = {num_t(nom), num_t(den)};
+	return true;
+}
+
+static int compareWords(Word left, Word right) noexcept
+{
+	const result_t
+			leftProduct = result_t(left.nom) * right.den,
+			rightProduct = result_t(right.nom) * left.den;
+
+	return leftProduct < rightProduct ? -1 : leftProduct > rightProduct;
+}
+
+
+// Values with single chunk vectors under equal exponents are fractions of these chunks
+static inline bool isWord(const number &num) noexcept
+{
+	return (num.nom().size() == 1) & (num.den().size() == 1) & (num.nomExp() == num.denExp());
+}
+
+// Word arithmetic expects coprime chunks, which canonical values have
+static inline bool areCanonicalWords(const number &left, const number &right) noexcept
+{
+	return isWord(left) & isWord(right) & left.isCanonical() & right.isCanonical();
+}
+
+static inline Word toWord(const number &num) noexcept
+{
+	return {num.nom().front(), num.den().front()};
+}
+
+
+
+//-MULTIPLICATION-FUNCTIONS--------------------------------------------------------------------------------------------
+//    Buffer multiplication algorithms, rproduct chooses between them by the sizes of the operands
+
+
+static void rproduct(num_t *dest,
+					 const num_t *bigger, size_t biggerSize,
+					 const num_t *smaller, size_t smallerSize);
+static void rsquare(num_t *dest, const num_t *num, size_t size);
+
+
+// Propagates a carry through the buffer num, until it is absorbed
+//     num size >= count
+
+static void rcarry(num_t *__restrict num, size_t count, num_t carry) noexcept
+{
+	while(carry && count--) {
+		const num_t value = num_t(*num + carry);
+
+		carry = value < carry ? 1 : 0;
+		*num-- = value;
+	}
+}
+
+
+// Computes the absolute difference of buffers left and right into dest, and returns true if left < right
+//     leftSize  >= rightSize
+//     dest size >= leftSize
+
+static bool rabsdiff(num_t *__restrict dest,
+					 const num_t *__restrict left, size_t leftSize,
+					 const num_t *__restrict right, size_t rightSize
+) noexcept
+{
+	const size_t upper = leftSize - rightSize;
+
+	const num_t *const leftUpper = left - (leftSize - 1);
+	num_t *const destUpper = dest - (leftSize - 1);
+
+	const bool negative =
+			std::all_of(leftUpper, leftUpper + upper, [](const auto &value) { return !value; }) &&
+			rcmp(left, right, rightSize) < 0;
+
+	// Upper chunks of the difference come from left, which are all zero if it is the smaller one
+	if(negative) {
+		rsub(dest, right, left, rightSize);
+		std::fill(destUpper, destUpper + upper, 0);
+	}
+	else {
+		const auto borrow = num_t(rsub(dest, left, right, rightSize));
+
+		std::copy(leftUpper, leftUpper + upper, destUpper);
+		rborrow(dest - rightSize, upper, borrow);
+	}
+
+	return negative;
+}
+
+
+// Adds the middle term of Karatsuba's method to the outer products in dest
+//     middle = lower^2 + upper^2 -/+ diffProduct, where diffProduct is (lower - upper) * (lower - upper)
+//     middle size >= 2 * half + 1, diffProduct size >= 2 * half
+
+static void rcombine(num_t *__restrict dest, size_t size, size_t half,
+					 num_t *__restrict middle, const num_t *__restrict diffProduct, bool negative) noexcept
+{
+	const size_t upperSize = size - 2 * half;
+
+	std::copy(dest - (2 * half - 1), dest + 1, middle - 2 * half + 1);
+	*(middle - 2 * half) = 0;
+	rcarry(middle - upperSize, 2 * half + 1 - upperSize, num_t(rsum(middle, dest - 2 * half, upperSize)));
+
+	if(negative)
+		rcarry(middle - 2 * half, 1, num_t(rsum(middle, diffProduct, 2 * half)));
+	else
+		rborrow(middle - 2 * half, 1, num_t(rdiff(middle, diffProduct, 2 * half)));
+
+	const size_t middleSize = std::min(2 * half + 1, size - half);
+
+	rcarry(dest - half - middleSize, size - half - middleSize, num_t(rsum(dest - half, middle, middleSize)));
+}
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest, with Karatsuba's method
+//     (biggerSize + 1) / 2 < smallerSize <= biggerSize
+//     dest size >= biggerSize + smallerSize
+
+static void rkaratsuba(num_t *dest,
+					   const num_t *bigger, size_t biggerSize,
+					   const num_t *smaller, size_t smallerSize)
+{
+	// Operands are split at half, where the lower halves are the bigger ones
+	const size_t
+			half = (biggerSize + 1) / 2,
+			biggerUpper = biggerSize - half,
+			smallerUpper = smallerSize - half,
+			size = biggerSize + smallerSize;
+
+	const Scratch<> buffer(6 * half + 1);
+
+	num_t
+			*const biggerDiff = buffer.data() + half - 1,
+			*const smallerDiff = biggerDiff + half,
+			*const diffProduct = smallerDiff + 2 * half,
+			*const middle = diffProduct + 2 * half + 1;
+
+	const bool negative =
+			rabsdiff(biggerDiff, bigger, half, bigger - half, biggerUpper) !=
+			rabsdiff(smallerDiff, smaller, half, smaller - half, smallerUpper);
+
+	// Outer products are written directly to their place in dest
+	forkJoin<3>(smallerSize >= number::ParallelThreshold, [&](size_t task) {
+		if(task == 0)
+			rproduct(dest, bigger, half, smaller, half);
+		else if(task == 1)
+			rproduct(dest - 2 * half, bigger - half, biggerUpper, smaller - half, smallerUpper);
+		else
+			rproduct(diffProduct, biggerDiff, half, smallerDiff, half);
+	});
+
+	rcombine(dest, size, half, middle, diffProduct, negative);
+}
+
+
+// Compute a recursive square of a buffer num into dest, with Karatsuba's method
+//     dest size >= 2 * size
+
+static void rkaratsubasqr(num_t *dest, const num_t *num, size_t size)
+{
+	const size_t half = (size + 1) / 2;
+
+	const Scratch<> buffer(5 * half + 1);
+
+	num_t
+			*const diff = buffer.data() + half - 1,
+			*const diffSquare = diff + 2 * half,
+			*const middle = diffSquare + 2 * half + 1;
+
+	rabsdiff(diff, num, half, num - half, size - half);
+
+	forkJoin<3>(size >= number::ParallelThreshold, [&](size_t task) {
+		if(task == 0)
+			rsquare(dest, num, half);
+		else if(task == 1)
+			rsquare(dest - 2 * half, num - half, size - half);
+		else
+			rsquare(diffSquare, diff, half);
+	});
+
+	rcombine(dest, 2 * size, half, middle, diffSquare, false);
+}
+
+
+// Adds buffer src to two's-complement buffer dest, or subtracts it from dest
+//     count >= srcCount
+
+static void raddsigned(num_t *__restrict dest, size_t count, const num_t *__restrict src, size_t srcCount, bool subtract)
+{
+	if(subtract)
+		rborrow(dest - srcCount, count - srcCount, num_t(rdiff(dest, src, srcCount)));
+	else
+		rcarry(dest - srcCount, count - srcCount, num_t(rsum(dest, src, srcCount)));
+}
+
+
+// Shifts a two's-complement buffer num right by one bit, keeping its sign
+
+static void rhalve(num_t *num, size_t count) noexcept
+{
+	const num_t sign = *(num - (count - 1)) & (num_t(1) << (number::ChunkBits - 1));
+
+	rshr(num, count, 1);
+	*(num - (count - 1)) |= sign;
+}
+
+
+// Evaluates a polynomial with coefficients split from buffer num in points 1, -1 and 2
+//     returns true if the value in -1 is negative
+//     one, minusOne, two size >= part + 1
+
+static bool revaluate(num_t *one, num_t *minusOne, num_t *two,
+					  const num_t *num, size_t part, size_t upper)
+{
+	const num_t
+			*const lower = num,
+			*const middle = num - part,
+			*const high = num - 2 * part;
+
+	// one temporarily holds lower + high
+	std::copy(lower - (part - 1), lower + 1, one - (part - 1));
+	*(one - part) = 0;
+	rcarry(one - upper, part + 1 - upper, num_t(rsum(one, high, upper)));
+
+	// lower + high - middle
+	const bool negative = rabsdiff(minusOne, one, part + 1, middle, part);
+
+	rcarry(one - part, 1, num_t(rsum(one, middle, part)));
+
+	// (high * 2 + middle) * 2 + lower
+	std::fill(two - part, two + 1, 0);
+	std::copy(high - (upper - 1), high + 1, two - (upper - 1));
+	rshl(two, part + 1, 1);
+	rcarry(two - part, 1, num_t(rsum(two, middle, part)));
+	rshl(two, part + 1, 1);
+	rcarry(two - part, 1, num_t(rsum(two, lower, part)));
+
+	return negative;
+}
+
+
+// Interpolates the coefficients of the product polynomial of Toom-3 from its values, and adds them to dest
+//     dest holds the products in points 0 and infinity, one, minusOne and two hold the products in 1, -1 and 2
+//     one, minusOne, two, scratch size >= 2 * part + 2
+
+static void rinterpolate(num_t *dest, size_t size, size_t part, size_t upperSize,
+						 num_t *one, num_t *minusOne, num_t *two, num_t *scratch)
+{
+	const size_t width = 2 * part + 2;
+
+	// Interpolation over two's-complement values of width chunks
+	//     two      = (w(2) - w(-1)) / 3
+	//     one      = (w(1) - w(-1)) / 2
+	//     minusOne = w(-1) - w(0)
+	//     two      = (two - minusOne) / 2 - 2 * w(inf)
+	//     minusOne = minusOne + one - w(inf)
+	//     two      = two - one
+	//     one      = one - two
+	const num_t
+			*const zero = dest,
+			*const infinity = dest - 4 * part,
+			three[] = {3};
+
+	raddsigned(two, width, minusOne, width, true);
+	std::copy(two - (width - 1), two + 1, scratch - (width - 1));
+	rdivexact(two, scratch, width, three, 1, inverse(3));
+
+	raddsigned(one, width, minusOne, width, true);
+	rhalve(one, width);
+
+	raddsigned(minusOne, width, zero, 2 * part, true);
+
+	raddsigned(two, width, minusOne, width, true);
+	rhalve(two, width);
+	raddsigned(two, width, infinity, upperSize, true);
+	raddsigned(two, width, infinity, upperSize, true);
+
+	raddsigned(minusOne, width, one, width, false);
+	raddsigned(minusOne, width, infinity, upperSize, true);
+
+	raddsigned(two, width, one, width, true);
+	raddsigned(one, width, two, width, true);
+
+	// Coefficients are now non-negative, and are accumulated between the outer products
+	std::fill(dest - (4 * part - 1), dest - 2 * part + 1, 0);
+
+	const auto accumulate = [dest, size, width](const num_t *coefficient, size_t offset) {
+		const size_t count = std::min(width, size - offset);
+
+		rcarry(dest - offset - count, size - offset - count, num_t(rsum(dest - offset, coefficient, count)));
+	};
+
+	accumulate(one, part);
+	accumulate(minusOne, 2 * part);
+	accumulate(two, 3 * part);
+}
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest, with the Toom-3 method
+//     2 * ((biggerSize + 2) / 3) < smallerSize <= biggerSize
+//     dest size >= biggerSize + smallerSize
+
+static void rtoom3(num_t *dest,
+				   const num_t *bigger, size_t biggerSize,
+				   const num_t *smaller, size_t smallerSize)
+{
+	// Operands are split into thirds, where the upper thirds may be shorter
+	const size_t
+			part = (biggerSize + 2) / 3,
+			biggerUpper = biggerSize - 2 * part,
+			smallerUpper = smallerSize - 2 * part,
+			size = biggerSize + smallerSize,
+			upperSize = biggerUpper + smallerUpper,
+			evalSize = part + 1,
+			width = 2 * part + 2;
+
+	const Scratch<> buffer(6 * evalSize + 4 * width);
+
+	num_t
+			*const biggerOne = buffer.data() + evalSize - 1,
+			*const biggerMinusOne = biggerOne + evalSize,
+			*const biggerTwo = biggerMinusOne + evalSize,
+			*const smallerOne = biggerTwo + evalSize,
+			*const smallerMinusOne = smallerOne + evalSize,
+			*const smallerTwo = smallerMinusOne + evalSize,
+			*const one = smallerTwo + width,
+			*const minusOne = one + width,
+			*const two = minusOne + width,
+			*const scratch = two + width;
+
+	const bool negative =
+			revaluate(biggerOne, biggerMinusOne, biggerTwo, bigger, part, biggerUpper) !=
+			revaluate(smallerOne, smallerMinusOne, smallerTwo, smaller, part, smallerUpper);
+
+	// Products in points 0 and infinity are written directly to their place in dest
+	forkJoin<5>(smallerSize >= number::ParallelThreshold, [&](size_t task) {
+		if(task == 0)
+			rproduct(dest, bigger, part, smaller, part);
+		else if(task == 1)
+			rproduct(dest - 4 * part, bigger - 2 * part, biggerUpper, smaller - 2 * part, smallerUpper);
+		else if(task == 2)
+			rproduct(one, biggerOne, evalSize, smallerOne, evalSize);
+		else if(task == 3)
+			rproduct(minusOne, biggerMinusOne, evalSize, smallerMinusOne, evalSize);
+		else
+			rproduct(two, biggerTwo, evalSize, smallerTwo, evalSize);
+	});
+
+	if(negative)
+		rneg(minusOne, width);
+
+	rinterpolate(dest, size, part, upperSize, one, minusOne, two, scratch);
+}
+
+
+// Compute a recursive square of a buffer num into dest, with the Toom-3 method
+//     dest size >= 2 * size
+
+static void rtoom3sqr(num_t *dest, const num_t *num, size_t size)
+{
+	const size_t
+			part = (size + 2) / 3,
+			upper = size - 2 * part,
+			evalSize = part + 1,
+			width = 2 * part + 2;
+
+	const Scratch<> buffer(3 * evalSize + 4 * width);
+
+	num_t
+			*const numOne = buffer.data() + evalSize - 1,
+			*const numMinusOne = numOne + evalSize,
+			*const numTwo = numMinusOne + evalSize,
+			*const one = numTwo + width,
+			*const minusOne = one + width,
+			*const two = minusOne + width,
+			*const scratch = two + width;
+
+	// Squares are never negative, so the sign of the value in -1 does not matter
+	revaluate(numOne, numMinusOne, numTwo, num, part, upper);
+
+	forkJoin<5>(size >= number::ParallelThreshold, [&](size_t task) {
+		if(task == 0)
+			rsquare(dest, num, part);
+		else if(task == 1)
+			rsquare(dest - 4 * part, num - 2 * part, upper);
+		else if(task == 2)
+			rsquare(one, numOne, evalSize);
+		else if(task == 3)
+			rsquare(minusOne, numMinusOne, evalSize);
+		else
+			rsquare(two, numTwo, evalSize);
+	});
+
+	rinterpolate(dest, 2 * size, part, 2 * upper, one, minusOne, two, scratch);
+}
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest, where bigger is at least twice as big
+//     dest size >= biggerSize + smallerSize
+
+static void rslices(num_t *dest,
+					const num_t *bigger, size_t biggerSize,
+					const num_t *smaller, size_t smallerSize)
+{
+	const Scratch<> buffer(2 * smallerSize);
+	num_t *const product = buffer.data() + 2 * smallerSize - 1;
+
+	std::fill(dest - (biggerSize + smallerSize - 1), dest + 1, 0);
+
+	// Bigger is cut into slices of the smaller size, so that every partial product is balanced
+	for(size_t offset = 0; offset < biggerSize; offset += smallerSize) {
+		const size_t
+				slice = std::min(smallerSize, biggerSize - offset),
+				remaining = biggerSize + smallerSize - offset;
+
+		rproduct(product, smaller, smallerSize, bigger - offset, slice);
+
+		rcarry(dest - offset - (slice + smallerSize), remaining - (slice + smallerSize),
+			   num_t(rsum(dest - offset, product, slice + smallerSize)));
+	}
+}
+
+
+// Transform length in digits from which the stages of a number theoretic transform split into parallel halves
+static constexpr size_t ParallelTransformLength = size_t(1) << 16u;
+
+
+// Number theoretic transform over the field of integers modulo Prime, where Root generates its multiplicative group
+//     Chunks are transformed as 32-bit digits, with three primes the convolution of up to MaxLength digits is exact
+
+template<uint32_t Prime, uint32_t Root>
+struct NumberTheoreticTransform {
+	using digit_t = uint32_t;
+	using wide_t = uint64_t;
+
+	static constexpr wide_t Modulus = Prime;
+
+	static digit_t multiply(digit_t left, digit_t right) noexcept
+	{
+		return digit_t(wide_t(left) * right % Modulus);
+	}
+
+	static digit_t power(digit_t base, wide_t exp) noexcept
+	{
+		digit_t result = 1;
+
+		for(; exp; exp >>= 1u, base = multiply(base, base))
+			if(exp & 1u)
+				result = multiply(result, base);
+
+		return result;
+	}
+
+	// Multiplication by a constant twiddle with Shoup's precomputed quotient, result is in [0, 2 * Prime)
+	static digit_t multiply(digit_t value, digit_t twiddle, digit_t quotient) noexcept
+	{
+		const auto estimate = digit_t((wide_t(value) * quotient) >> 32u);
+		return digit_t(value * twiddle - estimate * Prime);
+	}
+
+	static digit_t reduce(digit_t value) noexcept { return value >= Prime ? value - Prime : value; }
+
+	// Twiddles of the stage with butterflies of half size m are stored at [m, 2 * m)
+	const Scratch<digit_t> twiddles, quotients;
+
+	NumberTheoreticTransform(size_t length, bool inverse) :
+			twiddles(length),
+			quotients(length)
+	{
+		for(size_t half = 1; half < length; half *= 2) {
+			const digit_t
+					principal = power(Root, (Modulus - 1) / (2 * half)),
+					step = inverse ? power(principal, Modulus - 2) : principal;
+
+			digit_t twiddle = 1;
+
+			for(size_t index = 0; index < half; ++index) {
+				twiddles[half + index] = twiddle;
+				quotients[half + index] = digit_t((wide_t(twiddle) << 32u) / Modulus);
+				twiddle = multiply(twiddle, step);
+			}
+		}
+	}
+
+	// Decimation in frequency, the result is in bit-reversed order
+	//     Long transforms split after their first stage into two independent transforms of the halves
+	void forward(digit_t *values, size_t length) const
+	{
+		if(length >= ParallelTransformLength) {
+			const size_t half = length / 2, quarter = half / 2;
+
+			forkJoin<2>(true, [&](size_t task) { forwardStage(values, half, task * quarter, quarter); });
+			forkJoin<2>(true, [&](size_t task) { forward(values + task * half, half); });
+
+			return;
+		}
+
+		for(size_t half = length / 2; half; half /= 2)
+			for(size_t start = 0; start < length; start += 2 * half)
+				forwardStage(values + start, half, 0, half);
+	}
+
+	// Decimation in time of bit-reversed values, the result is in natural order and scaled by length
+	//     Long transforms join two independent transforms of the halves in their last stage
+	void backward(digit_t *values, size_t length) const
+	{
+		if(length >= ParallelTransformLength) {
+			const size_t half = length / 2, quarter = half / 2;
+
+			forkJoin<2>(true, [&](size_t task) { backward(values + task * half, half); });
+			forkJoin<2>(true, [&](size_t task) { backwardStage(values, half, task * quarter, quarter); });
+
+			return;
+		}
+
+		for(size_t half = 1; half < length; half *= 2)
+			for(size_t start = 0; start < length; start += 2 * half)
+				backwardStage(values + start, half, 0, half);
+	}
+
+	// Butterflies first to first + count of a forward stage over lower and upper halves of size half
+	void forwardStage(digit_t *lower, size_t half, size_t first, size_t count) const noexcept
+	{
+		digit_t *const upper = lower + half;
+
+		for(size_t index = first; index < first + count; ++index) {
+			const digit_t
+					left = lower[index],
+					right = upper[index];
+
+			lower[index] = reduce(left + right);
+			upper[index] = reduce(multiply(left + Prime - right, twiddles[half + index], quotients[half + index]));
+		}
+	}
+
+	// Butterflies first to first + count of a backward stage over lower and upper halves of size half
+	void backwardStage(digit_t *lower, size_t half, size_t first, size_t count) const noexcept
+	{
+		digit_t *const upper = lower + half;
+
+		for(size_t index = first; index < first + count; ++index) {
+			const digit_t
+					left = lower[index],
+					right = reduce(multiply(upper[index], twiddles[half + index], quotients[half + index]));
+
+			lower[index] = reduce(left + right);
+			upper[index] = reduce(left + Prime - right);
+		}
+	}
+
+	// Computes the cyclic convolution of digits of buffers bigger and smaller into result
+	static void convolve(digit_t *result, size_t length,
+						 const num_t *bigger, size_t biggerSize,
+						 const num_t *smaller, size_t smallerSize)
+	{
+		const NumberTheoreticTransform
+				transform(length, false),
+				inverse(length, true);
+
+		// A square needs only one forward transform
+		if((bigger == smaller) & (biggerSize == smallerSize)) {
+			load(result, length, bigger, biggerSize);
+			transform.forward(result, length);
+
+			for(size_t index = 0; index < length; ++index)
+				result[index] = multiply(result[index], result[index]);
+		}
+		else {
+			const Scratch<digit_t> buffer(length);
+
+			forkJoin<2>(length >= ParallelTransformLength, [&](size_t task) {
+				if(task == 0) {
+					load(result, length, bigger, biggerSize);
+					transform.forward(result, length);
+				}
+				else {
+					load(buffer.data(), length, smaller, smallerSize);
+					transform.forward(buffer.data(), length);
+				}
+			});
+
+			for(size_t index = 0; index < length; ++index)
+				result[index] = multiply(result[index], buffer[index]);
+		}
+
+		inverse.backward(result, length);
+
+		const digit_t scale = power(digit_t(length % Modulus), Modulus - 2);
+
+		for(size_t index = 0; index < length; ++index)
+			result[index] = multiply(result[index], scale);
+	}
+
+	// Splits chunks of num into digits reduced modulo Prime, padded with zeros to length
+	static void load(digit_t *digits, size_t length, const num_t *num, size_t count)
+	{
+		constexpr digits_t DigitsPerChunk = number::ChunkBits / 32;
+
+		for(size_t index = 0; index < count * DigitsPerChunk; ++index)
+			digits[index] = digit_t(((num[-exp_t(index / DigitsPerChunk)] >> (32 * (index % DigitsPerChunk))) & 0xffffffffu) % Modulus);
+
+		std::fill(digits + count * DigitsPerChunk, digits + length, 0);
+	}
+};
+
+using NttFirst = NumberTheoreticTransform<998244353u, 3u>;
+using NttSecond = NumberTheoreticTransform<167772161u, 3u>;
+using NttThird = NumberTheoreticTransform<469762049u, 3u>;
+
+// Longest transform supported by all three primes, and the longest product in chunks it can compute
+static constexpr size_t NttMaxLength = size_t(1) << 23u;
+static constexpr size_t NttMaxSize = NttMaxLength / (number::ChunkBits / 32);
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest, with a number theoretic transform
+//     digits of bigger and smaller together fit into NttMaxLength
+//     dest size >= biggerSize + smallerSize
+
+static void rntt(num_t *dest,
+				 const num_t *bigger, size_t biggerSize,
+				 const num_t *smaller, size_t smallerSize)
+{
+	using digit_t = uint32_t;
+	using wide_t = uint64_t;
+
+	constexpr digits_t DigitsPerChunk = number::ChunkBits / 32;
+	constexpr wide_t
+			FirstPrime = NttFirst::Modulus,
+			SecondPrime = NttSecond::Modulus,
+			ThirdPrime = NttThird::Modulus;
+
+	const size_t digits = (biggerSize + smallerSize) * DigitsPerChunk;
+
+	size_t length = 1;
+	while(length < digits)
+		length *= 2;
+
+	const Scratch<digit_t> residues(3 * length);
+
+	digit_t
+			*const first = residues.data(),
+			*const second = first + length,
+			*const third = second + length;
+
+	// Convolutions modulo the three primes are independent
+	forkJoin<3>(smallerSize >= number::ParallelThreshold, [&](size_t task) {
+		if(task == 0)
+			NttFirst::convolve(first, length, bigger, biggerSize, smaller, smallerSize);
+		else if(task == 1)
+			NttSecond::convolve(second, length, bigger, biggerSize, smaller, smallerSize);
+		else
+			NttThird::convolve(third, length, bigger, biggerSize, smaller, smallerSize);
+	});
+
+	// Garner's reconstruction, value = first + FirstPrime * (mixed + SecondPrime * high)
+	const digit_t
+			firstInverse = NttSecond::power(digit_t(FirstPrime % SecondPrime), SecondPrime - 2),
+			productInverse = NttThird::power(digit_t(FirstPrime * SecondPrime % ThirdPrime), ThirdPrime - 2);
+
+	std::fill(dest - (biggerSize + smallerSize - 1), dest + 1, 0);
+
+	wide_t carry = 0;
+
+	for(size_t index = 0; index < digits; ++index) {
+		const wide_t
+				low = first[index],
+				mixed = NttSecond::multiply(digit_t((second[index] + SecondPrime - low % SecondPrime) % SecondPrime), firstInverse),
+				partial = (low + FirstPrime * mixed) % ThirdPrime,
+				high = NttThird::multiply(digit_t((third[index] + ThirdPrime - partial) % ThirdPrime), productInverse);
+
+		// (high * SecondPrime + mixed) * FirstPrime + low, split into a 32-bit digit and the rest
+		const wide_t
+				upper = high * SecondPrime + mixed,
+				sum = (upper & 0xffffffffu) * FirstPrime + low + (carry & 0xffffffffu);
+
+		carry = (upper >> 32u) * FirstPrime + (sum >> 32u) + (carry >> 32u);
+
+		dest[-exp_t(index / DigitsPerChunk)] |= num_t(num_t(sum & 0xffffffffu) << (32 * (index % DigitsPerChunk)));
+	}
+}
+
+
+// Compute a recursive multiplication of buffers bigger and smaller into dest, choosing the algorithm by their sizes
+//     biggerSize   >= smallerSize
+//     dest size    >= biggerSize + smallerSize
+
+static void rproduct(num_t *dest,
+					 const num_t *bigger, size_t biggerSize,
+					 const num_t *smaller, size_t smallerSize)
+{
+	if((bigger == smaller) & (biggerSize == smallerSize))
+		rsquare(dest, bigger, biggerSize);
+	else if(smallerSize < number::KaratsubaThreshold)
+		rmul(dest, bigger, biggerSize, smaller, smallerSize);
+	else if(smallerSize >= number::NttThreshold && biggerSize + smallerSize <= NttMaxSize)
+		rntt(dest, bigger, biggerSize, smaller, smallerSize);
+	else if((biggerSize + 1) / 2 >= smallerSize)
+		rslices(dest, bigger, biggerSize, smaller, smallerSize);
+	else if(smallerSize >= number::Toom3Threshold && 2 * ((biggerSize + 2) / 3) < smallerSize)
+		rtoom3(dest, bigger, biggerSize, smaller, smallerSize);
+	else
+		rkaratsuba(dest, bigger, biggerSize, smaller, smallerSize);
+}
+
+
+
+// Compute a recursive square of a buffer num into dest, choosing the algorithm by its size
+//     dest size >= 2 * size
+
+static void rsquare(num_t *dest, const num_t *num, size_t size)
+{
+	if(size < number::KaratsubaSquareThreshold)
+		rsqr(dest, num, size);
+	else if(size >= number::NttThreshold && 2 * size <= NttMaxSize)
+		rntt(dest, num, size, num, size);
+	else if(size >= number::Toom3SquareThreshold)
+		rtoom3sqr(dest, num, size);
+	else
+		rkaratsubasqr(dest, num, size);
+}
+
+
+
+//-DIVISION-FUNCTIONS--------------------------------------------------------------------------------------------------
+//    Recursive division of Burnikel and Ziegler, that splits the division into halves until they are small enough for
+//    the schoolbook one, and does the rest of the work in multiplications
+
+
+static void rdivide32(num_t *dest, num_t *num, const num_t *div, size_t half);
+
+
+// Compute a recursive division of a buffer num of 2 * size chunks by a normalized buffer div, with the quotient into
+// dest and the remainder left in the lowest size chunks of num
+//     the top chunk of div has its highest bit set, size >= 2
+//     num size  >= 2 * size, where the top size chunks of num are below div
+//     div size  >= size
+//     dest size >= size
+
+static void rdivide21(num_t *dest, num_t *num, const num_t *div, size_t size)
+{
+	if((size < number::BurnikelZieglerThreshold) | (size & 1u)) {
+		rdivrem(dest, num, size, div, size);
+		return;
+	}
+
+	const size_t half = size / 2;
+
+	// Each half of the quotient comes from three quarters of num, where the upper one continues with the remainder
+	rdivide32(dest - half, num - half, div, half);
+	rdivide32(dest, num, div, half);
+}
+
+
+// Compute a recursive division of a buffer num of 3 * half chunks by a normalized buffer div of 2 * half chunks, with
+// the quotient into dest and the remainder left in the lowest 2 * half chunks of num
+//     the top chunk of div has its highest bit set
+//     num size  >= 3 * half, where the top 2 * half chunks of num are below div
+//     div size  >= 2 * half
+//     dest size >= half
+
+static void rdivide32(num_t *dest, num_t *num, const num_t *div, size_t half)
+{
+	const size_t size = 2 * half;
+
+	num_t
+			*const numTop = num - half,
+			*const numHigh = num - size;
+
+	const num_t *const divHigh = div - half;
+
+	// The quotient is estimated from the top halves, where the upper halves being equal gives the biggest value
+	if(rcmp(numHigh, divHigh, half) < 0)
+		rdivide21(dest, numTop, divHigh, half);
+	else {
+		std::fill(dest - (half - 1), dest + 1, number::ResultMask);
+
+		// [numHigh numTop] - (B^half - 1) * divHigh, where numHigh equals divHigh
+		rdiff(numHigh, divHigh, half);
+		rcarry(numHigh, half, num_t(rsum(numTop, divHigh, half)));
+	}
+
+	// Remainder of the estimate is [remainder num] - estimate * divLow, which is above -2 * div
+	Scratch<> product(size);
+	rproduct(product.data() + size - 1, div, half, dest, half);
+
+	rborrow(numHigh, half, num_t(rdiff(num, product.data() + size - 1, size)));
+
+	// The top half is zero for a positive remainder, and full of ones for a negative one
+	while(*(num - (size + half - 1))) {
+		rcarry(numHigh, half, num_t(rsum(num, div, size)));
+		rborrow(dest, half, 1);
+	}
+}
+
+
+
+//-VECTOR-ARITHMETIC-FUNCTIONS-----------------------------------------------------------------------------------------
+//    These are the functions that operate on vectors and exponents, in abstraction they are between the number class
+//    and low level recursive computations that try to never allocate
+//    They mostly prepare buffers and handle control flow if the computation is more complex
+
+
+// Basic vector operations
+
+static inline num_t *rptr(data_t &vec) noexcept { return vec.data() + vec.size() - 1; }
+static inline const num_t *rptr(const data_t &vec) noexcept { return vec.data() + vec.size() - 1; }
+static inline exp_t minExp(exp_t exp, const data_t &vec) noexcept { return exp - exp_t(vec.size()); }
+
+// Position of the bit above the highest set bit of a non-zero truncated vector, relative to the chunk point
+static inline exp_t bitLength(exp_t exp, const data_t &vec) noexcept
+{
+	return exp * exp_t(number::ChunkBits) - exp_t(leadingZeros(vec.front()));
+}
+
+static inline exp_t pushFront(data_t &vec, num_t value, size_t count = 1)
+{
+	vec.insert(vec.begin(), count, value);
+	return exp_t(count);
+}
+
+
+// Removes all trailing and leading zeros from the vector and returns the new exponent
+static exp_t truncate(exp_t exp, data_t &vec)
+{
+	const auto
+			front = std::find_if(vec.begin(), vec.end(), [](const auto &value) { return value; }),
+			back = std::find_if(vec.rbegin(), vec.rend(), [](const auto &value) { return value; }).base();
+
+	// Vector is full of zeros
+	if(back <= front) {
+		vec.clear();
+
+		return 0;
+	}
+	else {
+		// Change in exponent is the number of leading zeros
+		const exp_t expChange = std::distance(vec.begin(), front);
+
+		// Trailing zeros are cut off, and the leading ones are dropped by moving the front of the view
+		vec.resize(size_t(std::distance(vec.begin(), back)));
+		vec.erase(vec.begin(), front);
+
+		return exp - expChange;
+	}
+}
+
+
+// Turn an overflown two's-complement vector into a positive one
+static inline Sign turnNegative(data_t &vec) noexcept
+{
+	rneg(rptr(vec), vec.size());
+	return Sign::Negative;
+}
+
+
+// Places two vectors into result over their common range of exponents, with an extra chunk on top for overflow
+//     result holds left, and the return value points to the position where the last chunk of right belongs
+
+static num_t *place(data_t &result,
+					exp_t leftExp, const data_t &left,
+					exp_t rightExp, const data_t &right)
+{
+	const exp_t
+			upperExp = std::max(leftExp, rightExp),
+			lowerMinExp = std::min(minExp(leftExp, left), minExp(rightExp, right));
+
+	result.clear();
+	result.resize(size_t(upperExp - lowerMinExp) + 1);
+
+	num_t *const leftEnd = rptr(result) - (minExp(leftExp, left) - lowerMinExp);
+	std::copy(left.begin(), left.end(), leftEnd - exp_t(left.size() - 1));
+
+	return rptr(result) - (minExp(rightExp, right) - lowerMinExp);
+}
+
+
+// Adds two vectors into result, and returns the final exponent
+static exp_t add(data_t &result,
+				 exp_t leftExp, const data_t &left,
+				 exp_t rightExp, const data_t &right)
+{
+	num_t *const rightEnd = place(result, leftExp, left, rightExp, right);
+	const auto above = size_t(rightEnd - result.data()) + 1 - right.size();
+
+	rcarry(rightEnd - right.size(), above, num_t(rsum(rightEnd, rptr(right), right.size())));
+
+	return truncate(std::max(leftExp, rightExp) + 1, result);
+}
+
+
+// Subtracts two vectors into result, and returns the final exponent and sign
+struct SubResult {
+	exp_t exp;
+	Sign sign;
+};
+
+static SubResult sub(data_t &result,
+					 exp_t leftExp, const data_t &left,
+					 exp_t rightExp, const data_t &right)
+{
+	num_t *const rightEnd = place(result, leftExp, left, rightExp, right);
+	const auto above = size_t(rightEnd - result.data()) + 1 - right.size();
+
+	rborrow(rightEnd - right.size(), above, num_t(rdiff(rightEnd, rptr(right), right.size())));
+
+	// Negative result overflows into the top chunk
+	Sign sign = Sign::Positive;
+
+	if(result.front())
+		sign = turnNegative(result);
+
+	return {
+			truncate(std::max(leftExp, rightExp) + 1, result),
+			sign
+	};
+}
+
+
+// Multiplies two vectors into buffer dest, where the product takes left.size() + right.size() chunks
+static void product(num_t *dest, const data_t &left, const data_t &right)
+{
+	if(left.size() >= right.size())
+		rproduct(dest, rptr(left), left.size(), rptr(right), right.size());
+	else
+		rproduct(dest, rptr(right), right.size(), rptr(left), left.size());
+}
+
+
+// Multiplies two vectors into result, and returns the final exponent
+static exp_t multiply(data_t &result,
+					  exp_t leftExp, const data_t &left,
+					  exp_t rightExp, const data_t &right)
+{
+	result.clear();
+	result.resize(left.size() + right.size());
+
+	product(rptr(result), left, right);
+
+	return truncate(leftExp + rightExp, result);
+}
+
+
+// Multiplies a vector by a chunk into result, and returns the final exponent
+static exp_t multiplyChunk(data_t &result, exp_t exp, const data_t &vec, num_t value)
+{
+	result.clear();
+	result.resize(vec.size() + 1);
+
+	result.front() = rmul(rptr(result), rptr(vec), vec.size(), value);
+
+	return truncate(exp + 1, result);
+}
+
+// Divides a vector by a chunk that divides it exactly into result, and returns the final exponent
+static exp_t divideChunk(data_t &result, exp_t exp, const data_t &vec, num_t value)
+{
+	result.clear();
+	result.resize(vec.size());
+
+	rdiv(rptr(result), rptr(vec), vec.size(), value);
+
+	return truncate(exp, result);
+}
+
+
+// Compares the products left * leftFactor and right * rightFactor of non-zero vectors, and returns their order
+static int compareProducts(exp_t leftExp, const data_t &left, exp_t leftFactorExp, const data_t &leftFactor,
+						   exp_t rightExp, const data_t &right, exp_t rightFactorExp, const data_t &rightFactor)
+{
+	size_t
+			leftSize = left.size() + leftFactor.size(),
+			rightSize = right.size() + rightFactor.size();
+
+	const Scratch<> buffer(leftSize + rightSize);
+
+	const num_t
+			*leftProduct = buffer.data(),
+			*rightProduct = leftProduct + leftSize;
+
+	product(buffer.data() + leftSize - 1, left, leftFactor);
+	product(buffer.data() + leftSize + rightSize - 1, right, rightFactor);
+
+	exp_t
+			leftUpperExp = leftExp + leftFactorExp,
+			rightUpperExp = rightExp + rightFactorExp;
+
+	// A product can have a leading zero chunk
+	if(!*leftProduct) {
+		++leftProduct;
+		--leftSize;
+		--leftUpperExp;
+	}
+	if(!*rightProduct) {
+		++rightProduct;
+		--rightSize;
+		--rightUpperExp;
+	}
+
+	if(leftUpperExp != rightUpperExp)
+		return leftUpperExp < rightUpperExp ? -1 : 1;
+
+	const size_t common = std::min(leftSize, rightSize);
+
+	if(const int order = rcmp(leftProduct + common - 1, rightProduct + common - 1, common))
+		return order;
+
+	// The longer product is bigger if any of its remaining lower chunks is non-zero
+	const auto nonZero = [](const auto &value) { return value; };
+
+	if(std::any_of(leftProduct + common, leftProduct + leftSize, nonZero))
+		return 1;
+	else
+		return std::any_of(rightProduct + common, rightProduct + rightSize, nonZero) ? -1 : 0;
+}
+
+
+// Raises integer buffer num of size chunks to power exp > 0 into integer vector result
+//     A left-to-right sliding window over the bits of exp multiplies by odd powers num^1, num^3, ... from a table, so
+//     there is a square per bit of exp, and a multiplication only per window of width bits
+
+static void slidingPower(data_t &result, const num_t *num, size_t size, uexp_t exp)
+{
+	struct Value {
+		const num_t *data;
+		size_t size;
+	};
+
+	digits_t expBits = 0;
+
+	for(uexp_t rest = exp; rest; rest >>= 1)
+		++expBits;
+
+	// A wider window saves multiplications in the scan, but doubles the table
+	constexpr digits_t MaxWidth = 3;
+
+	const digits_t width = expBits > 24 ? MaxWidth : expBits > 6 ? 2 : 1;
+	const size_t entries = size_t(1) << (width - 1);
+
+	// Power p of num has at most p times its bits, and an untrimmed product one more chunk
+	const uexp_t numBits = size * number::ChunkBits - leadingZeros(num[0]);
+	const auto bound = [numBits](uexp_t power) { return size_t(power * numBits / number::ChunkBits) + 2; };
+
+	// Products are written into dest, without the leading zero chunk they can have
+	const auto multiply = [](num_t *dest, Value left, Value right) {
+		if(left.size < right.size)
+			std::swap(left, right);
+
+		rproduct(dest + left.size + right.size - 1,
+				 left.data + left.size - 1, left.size,
+				 right.data + right.size - 1, right.size);
+
+		const bool leadingZero = !dest[0];
+		return Value{dest + leadingZero, left.size + right.size - leadingZero};
+	};
+
+	size_t tableSize = bound(2);
+
+	for(size_t index = 0; index < entries; ++index)
+		tableSize += bound(2 * index + 1);
+
+	const Scratch<> tableBuffer(tableSize), valueBuffer(2 * bound(exp));
+
+	// Table holds num^(2 * index + 1), each entry is the previous one times the square
+	Value table[size_t(1) << (MaxWidth - 1)];
+	num_t *free = tableBuffer.data();
+
+	table[0] = {num, size};
+
+	if(entries > 1) {
+		const Value square = multiply(free, table[0], table[0]);
+		free += bound(2);
+
+		for(size_t index = 1; index < entries; ++index) {
+			table[index] = multiply(free, table[index - 1], square);
+			free += bound(2 * index + 1);
+		}
+	}
+
+	// The value is double buffered, products go to the half it is not in
+	Value value = {nullptr, 0};
+
+	num_t
+			*spareValue = valueBuffer.data(),
+			*otherValue = valueBuffer.data() + bound(exp);
+
+	const auto step = [&](Value right) {
+		value = multiply(spareValue, value, right);
+		std::swap(spareValue, otherValue);
+	};
+
+	for(digits_t bit = expBits; bit;) {
+		if(!((exp >> (bit - 1)) & 1u)) {
+			step(value);
+			--bit;
+			continue;
+		}
+
+		// A window ends at its lowest set bit, so it has an odd value
+		digits_t low = bit > width ? bit - width : 0;
+
+		while(!((exp >> low) & 1u))
+			++low;
+
+		const Value &entry = table[size_t((exp >> low) & ((uexp_t(1) << (bit - low)) - 1)) / 2];
+
+		// The first window starts from its entry
+		if(!value.data)
+			value = entry;
+		else {
+			for(digits_t shift = bit - low; shift; --shift)
+				step(value);
+
+			step(entry);
+		}
+
+		bit = low;
+	}
+
+	result.assign(value.data, value.data + value.size);
+}
+
+
+// Computes a vector to power exp into result, and returns the final exponent
+//     exp > 0
+//     The binary factor of the vector is raised by a shift and its exponent, so powers of two take no multiplications
+
+static exp_t power(data_t &result, exp_t numExp, const data_t &num, uexp_t exp)
+{
+	constexpr auto ChunkBits = uexp_t(number::ChunkBits);
+
+	// The integer of the vector is odd * 2^zeros, and the power of 2^zeros splits into whole chunks and a shift
+	const digits_t zeros = trailingZeros(num.back());
+	const uexp_t shift = zeros * exp;
+	const exp_t scale = minExp(numExp, num) * exp_t(exp) + exp_t(shift / ChunkBits);
+
+	const Scratch<> oddBuffer(num.size());
+	std::copy(num.begin(), num.end(), oddBuffer.data());
+
+	const num_t *odd = oddBuffer.data();
+	size_t oddSize = num.size();
+
+	if(zeros) {
+		rshr(oddBuffer.data() + oddSize - 1, oddSize, zeros);
+
+		if(!odd[0]) {
+			++odd;
+			--oddSize;
+		}
+	}
+
+	if((oddSize == 1) & (odd[0] == 1))
+		result.assign(1, 1);
+	else
+		slidingPower(result, odd, oddSize, exp);
+
+	if(const auto bits = digits_t(shift % ChunkBits)) {
+		const num_t overflow = rshl(rptr(result), result.size(), bits);
+
+		if(overflow)
+			pushFront(result, overflow);
+	}
+
+	return truncate(scale + exp_t(result.size()), result);
+}
+
+
+
+// Cuts a vector down to its most significant count chunks
+static inline void chop(data_t &vec, size_t count)
+{
+	if(vec.size() > count)
+		vec.resize(count);
+}
+
+// Copies the most significant count chunks of a vector into result
+static inline void chop(data_t &result, const data_t &vec, size_t count)
+{
+	result.assign(vec.begin(), vec.begin() + exp_t(std::min(count, vec.size())));
+}
+
+// Sets vec to a single chunk of the value 2^exponent, and returns its exponent
+static exp_t powerOfTwo(data_t &vec, exp_t exponent)
+{
+	constexpr auto ChunkBits = exp_t(number::ChunkBits);
+
+	const exp_t exp = exponent >= 0 ? exponent / ChunkBits : -((-exponent + ChunkBits - 1) / ChunkBits);
+
+	vec.assign(1, num_t(num_t(1) << size_t(exponent - exp * ChunkBits)));
+	return exp + 1;
+}
+
+
+// Computes a square root of a positive truncated vector into result with bits correct binary digits, and returns
+// the final exponent
+//     Newton's iteration for the inverse square root y' = y * (3 - num * y^2) / 2 needs no division, and it doubles
+//     the number of correct digits in every step, so each step runs only on operands chopped to what it can reach
+
+static exp_t squareRoot(data_t &result, exp_t numExp, const data_t &num, digits_t bits)
+{
+	constexpr digits_t ChunkBits = number::ChunkBits;
+
+	// A chunk of guard digits absorbs the errors of chopping
+	const size_t precision = size_t(bits) + ChunkBits;
+
+	const auto chunks = [](size_t digits) { return digits / ChunkBits + 2; };
+
+	// 2^-ceil(length / 2) is within a factor of two below the inverse square root
+	const exp_t length = bitLength(numExp, num);
+
+	data_t root, chopped, square, product, difference;
+	exp_t rootExp = powerOfTwo(root, length >= 0 ? -((length + 1) / 2) : -length / 2);
+
+	const data_t
+			three = {3},
+			half = {num_t(num_t(1) << (ChunkBits - 1))};
+
+	const auto step = [&](size_t digits) {
+		const size_t count = chunks(digits);
+
+		chop(chopped, num, count);
+		chop(root, count);
+
+		exp_t exp = multiply(square, rootExp, root, rootExp, root);
+		chop(square, count);
+
+		exp = multiply(product, numExp, chopped, exp, square);
+		chop(product, count);
+
+		// The product is close to one, so the difference stays positive
+		exp = sub(difference, 1, three, exp, product).exp;
+
+		exp = multiply(product, rootExp, root, exp, difference);
+		chop(product, count);
+
+		rootExp = multiply(root, exp, product, 0, half);
+	};
+
+	// The first steps converge from the factor of two to a chunk of correct digits, then every step doubles them
+	for(int warmup = 0; warmup < 7; ++warmup)
+		step(ChunkBits);
+
+	for(size_t digits = ChunkBits; digits < precision;) {
+		digits = std::min(2 * digits - 8, precision);
+		step(digits);
+	}
+
+	// sqrt(num) = num * y
+	const exp_t resultExp = multiply(result, numExp, num, rootExp, root);
+	chop(result, chunks(precision));
+
+	return truncate(resultExp, result);
+}
+
+
+// Computes a reciprocal of a positive truncated vector into result with bits correct binary digits, and returns the
+// final exponent
+//     Newton's iteration y' = y * (2 - num * y) doubles the number of correct digits in every step, and runs on
+//     chopped operands the same way as in squareRoot
+
+static exp_t reciprocal(data_t &result, exp_t numExp, const data_t &num, digits_t bits)
+{
+	constexpr digits_t ChunkBits = number::ChunkBits;
+
+	// A chunk of guard digits absorbs the errors of chopping
+	const size_t precision = size_t(bits) + ChunkBits;
+
+	const auto chunks = [](size_t digits) { return digits / ChunkBits + 2; };
+
+	// 2^-length is within a factor of two below the reciprocal
+	exp_t resultExp = powerOfTwo(result, -bitLength(numExp, num));
+
+	data_t chopped, product, difference;
+
+	const data_t two = {2};
+
+	const auto step = [&](size_t digits) {
+		const size_t count = chunks(digits);
+
+		chop(chopped, num, count);
+		chop(result, count);
+
+		exp_t exp = multiply(product, numExp, chopped, resultExp, result);
+		chop(product, count);
+
+		// The product is close to one, so the difference stays positive
+		exp = sub(difference, 1, two, exp, product).exp;
+
+		resultExp = multiply(product, resultExp, result, exp, difference);
+		std::swap(result, product);
+	};
+
+	// The error is squared in every step, so the first steps reach a chunk of correct digits from the factor of two
+	for(int warmup = 0; warmup < 6; ++warmup)
+		step(ChunkBits);
+
+	for(size_t digits = ChunkBits; digits < precision;) {
+		digits = std::min(2 * digits - 8, precision);
+		step(digits);
+	}
+
+	chop(result, chunks(precision));
+
+	return truncate(resultExp, result);
+}
+
+
+
+//-INTEGER-VECTOR-FUNCTIONS--------------------------------------------------------------------------------------------
+//    These functions treat truncated vectors as plain integers, ignoring their exponents
+
+
+static inline bool isOne(const data_t &vec) noexcept { return (vec.size() == 1) & (vec.front() == 1); }
+
+
+// Compares two integer vectors, and returns their order
+static int compare(const data_t &left, const data_t &right) noexcept
+{
+	if(left.size() != right.size())
+		return left.size() < right.size() ? -1 : 1;
+
+	return rcmp(rptr(left), rptr(right), left.size());
+}
+
+
+// Shifts an integer vector right by shift bits, where shift < ChunkBits
+static void shiftRight(data_t &vec, digits_t shift)
+{
+	if(shift) {
+		rshr(rptr(vec), vec.size(), shift);
+
+		if(!vec.front())
+			vec.erase(vec.begin());
+	}
+}
+
+
+// Shifts an integer vector left by shift bits, where shift < ChunkBits
+static void shiftLeft(data_t &vec, digits_t shift)
+{
+	if(shift) {
+		const num_t overflow = rshl(rptr(vec), vec.size(), shift);
+
+		if(overflow)
+			pushFront(vec, overflow);
+	}
+}
+
+
+// Removes the leading zeros of an integer vector
+static inline void trimFront(data_t &vec)
+{
+	vec.erase(vec.begin(), std::find_if(vec.begin(), vec.end(), [](const auto &value) { return value; }));
+}
+
+
+// Cuts a vector with its exponent down to its integer part, which keeps the trailing zero chunks of the integer
+static inline void integerPart(data_t &vec, exp_t exp)
+{
+	vec.resize(exp > 0 ? size_t(exp) : 0);
+}
+
+
+// Multiplies two integer vectors into result
+static void multiplyIntegers(data_t &result, const data_t &left, const data_t &right)
+{
+	integerPart(result, multiply(result, exp_t(left.size()), left, exp_t(right.size()), right));
+}
+
+
+// Subtracts integer vector other from vec in place, where vec >= other
+static void subtractFrom(data_t &vec, const data_t &other)
+{
+	if(!other.empty()) {
+		rborrow(rptr(vec) - other.size(), vec.size() - other.size(), num_t(rdiff(rptr(vec), rptr(other), other.size())));
+		trimFront(vec);
+	}
+}
+
+
+// Adds a chunk to integer vector vec in place
+static void increment(data_t &vec, num_t value)
+{
+	pushFront(vec, 0);
+	rcarry(rptr(vec), vec.size(), value);
+	trimFront(vec);
+}
+
+
+// Divides integer vector num by a non-zero integer vector divisor into quotient and remainder, given a reciprocal of
+// the divisor correct to at least a chunk more binary digits than the quotient has
+//     Integer vectors keep their trailing zero chunks here, and the quotient estimated from the reciprocal is off by
+//     at most a unit, which is corrected on the remainder
+
+static void divide(data_t &quotient, data_t &remainder,
+				   const data_t &num, const data_t &divisor,
+				   exp_t reciprocalExp, const data_t &reciprocal)
+{
+	if(compare(num, divisor) < 0) {
+		quotient.clear();
+		remainder = num;
+		return;
+	}
+
+	integerPart(quotient, multiply(quotient, exp_t(num.size()), num, reciprocalExp, reciprocal));
+
+	data_t multiple;
+
+	if(!quotient.empty()) {
+		multiple.resize(quotient.size() + divisor.size());
+		product(rptr(multiple), quotient, divisor);
+		trimFront(multiple);
+	}
+
+	while(compare(multiple, num) > 0) {
+		rborrow(rptr(quotient), quotient.size(), 1);
+		trimFront(quotient);
+		subtractFrom(multiple, divisor);
+	}
+
+	remainder = num;
+	subtractFrom(remainder, multiple);
+
+	while(compare(remainder, divisor) >= 0) {
+		increment(quotient, 1);
+		subtractFrom(remainder, divisor);
+	}
+}
+
+
+// Divides integer vector num by a non-zero integer vector divisor into quotient and remainder
+//     The divisor is normalized to a top chunk with its highest bit set, and padded with zero chunks to a size that
+//     halves evenly down to the schoolbook division, then num is divided in blocks of that size
+
+static void divide(data_t &quotient, data_t &remainder, const data_t &num, const data_t &divisor)
+{
+	if(compare(num, divisor) < 0) {
+		quotient.clear();
+		remainder = num;
+		return;
+	}
+	else if(divisor.size() == 1) {
+		quotient = num;
+
+		const num_t rest = rdiv(rptr(quotient), rptr(quotient), quotient.size(), divisor.front());
+		trimFront(quotient);
+
+		remainder.clear();
+
+		if(rest)
+			remainder.assign(1, rest);
+
+		return;
+	}
+
+	size_t size = divisor.size(), levels = 0;
+
+	for(; size >= number::BurnikelZieglerThreshold; ++levels)
+		size = (size + 1) / 2;
+
+	size <<= levels;
+
+	// The top block of num starts with a zero chunk, so that it is below the divisor
+	const size_t
+			extra = size - divisor.size(),
+			blocks = (num.size() + extra) / size + 1,
+			total = blocks * size;
+
+	const digits_t shift = leadingZeros(divisor.front());
+
+	Scratch<>
+			div(size),
+			buffer(total),
+			result(total - size);
+
+	std::copy(divisor.begin(), divisor.end(), div.data());
+	std::fill(div.data() + divisor.size(), div.data() + size, num_t(0));
+
+	num_t *const numBegin = buffer.data() + (total - extra - num.size());
+
+	std::fill(buffer.data(), numBegin, num_t(0));
+	std::copy(num.begin(), num.end(), numBegin);
+	std::fill(numBegin + num.size(), buffer.data() + total, num_t(0));
+
+	if(shift) {
+		rshl(div.data() + size - 1, size, shift);
+		rshl(buffer.data() + total - 1, total, shift);
+	}
+
+	// Every block of the quotient comes from the remainder so far followed by the next block of num
+	for(size_t block = blocks - 1; block--;)
+		rdivide21(result.data() + (blocks - 1 - block) * size - 1, buffer.data() + (blocks - block) * size - 1, div.data() + size - 1, size);
+
+	quotient.assign(result.data(), result.data() + (total - size));
+	trimFront(quotient);
+
+	// Remainder is in the lowest block, where the padding chunks stay zero
+	if(shift)
+		rshr(buffer.data() + total - 1, size, shift);
+
+	remainder.assign(buffer.data() + (total - size), buffer.data() + (total - extra));
+	trimFront(remainder);
+}
+
+
+// Computes the greatest common divisor of two non-zero integer vectors into result
+static void gcd(data_t &result, const data_t &left, const data_t &right)
+{
+	// A single chunk reduces the other value to its remainder, which leaves a gcd of two chunks
+	if((left.size() == 1) | (right.size() == 1)) {
+		const bool leftIsChunk = left.size() == 1;
+
+		const data_t
+				&chunk = leftIsChunk ? left : right,
+				&other = leftIsChunk ? right : left;
+
+		const num_t remainder = rmod(rptr(other), other.size(), chunk.front());
+
+		result.assign(1, remainder ? gcd(chunk.front(), remainder) : chunk.front());
+		return;
+	}
+
+	// A much longer value is reduced to its remainder by the shorter one first, which the binary gcd is slow at
+	if((left.size() > right.size() + 1) | (right.size() > left.size() + 1)) {
+		const bool leftIsLonger = left.size() > right.size();
+
+		const data_t
+				&longer = leftIsLonger ? left : right,
+				&shorter = leftIsLonger ? right : left;
+
+		data_t quotient, remainder;
+		divide(quotient, remainder, longer, shorter);
+
+		if(remainder.empty()) {
+			result = shorter;
+			return;
+		}
+
+		// Zero chunks at the end are dropped, the odd part keeps only the binary factors that the shorter value has too
+		if(!remainder.back()) {
+			while(!remainder.back())
+				remainder.pop_back();
+
+			shiftRight(remainder, trailingZeros(remainder.back()));
+			shiftLeft(remainder, trailingZeros(shorter.back()));
+		}
+
+		gcd(result, shorter, remainder);
+		return;
+	}
+
+	// Binary gcd, the common power of two is restored at the end
+	data_t odd = left;
+	result = right;
+
+	const digits_t
+			oddZeros = trailingZeros(odd.back()),
+			resultZeros = trailingZeros(result.back());
+
+	shiftRight(odd, oddZeros);
+	shiftRight(result, resultZeros);
+
+	for(;;) {
+		const int order = compare(odd, result);
+
+		if(!order)
+			break;
+		else if(order > 0)
+			std::swap(odd, result);
+
+		// Both values are odd, so their difference is even and the smaller one stays odd
+		const size_t
+				oddSize = odd.size(),
+				resultSize = result.size();
+
+		rborrow(rptr(result) - oddSize, resultSize - oddSize, num_t(rdiff(rptr(result), rptr(odd), oddSize)));
+
+		// Zero chunks at the end are whole powers of two, dropping them keeps the gcd
+		while(!result.back())
+			result.pop_back();
+
+		const auto front = std::find_if(result.begin(), result.end(), [](const auto &value) { return value; });
+		result.erase(result.begin(), front);
+
+		shiftRight(result, trailingZeros(result.back()));
+
+		if((odd.size() == 1) & (result.size() == 1)) {
+			result.front() = gcd(odd.front(), result.front());
+			break;
+		}
+	}
+
+	shiftLeft(result, std::min(oddZeros, resultZeros));
+}
+
+
+// Divides vector num by an integer vector divisor that is known to divide it, and returns the final exponent
+static exp_t divideExact(data_t &result, exp_t numExp, const data_t &num, const data_t &divisor)
+{
+	const exp_t numMinExp = minExp(numExp, num);
+
+	if(isOne(divisor)) {
+		result = num;
+		return numExp;
+	}
+
+	// Powers of two are shifted out of both, as the exact division requires an odd divisor
+	const digits_t zeros = trailingZeros(divisor.back());
+
+	Scratch<> remainder(num.size()), oddDivisor(divisor.size());
+	std::copy(num.begin(), num.end(), remainder.data());
+	std::copy(divisor.begin(), divisor.end(), oddDivisor.data());
+
+	num_t
+			*const remainderEnd = remainder.data() + num.size() - 1,
+			*const divEnd = oddDivisor.data() + divisor.size() - 1;
+
+	size_t remainderSize = num.size(), divSize = divisor.size();
+
+	if(zeros) {
+		rshr(remainderEnd, remainderSize, zeros);
+		rshr(divEnd, divSize, zeros);
+
+		remainderSize -= !remainder[0];
+		divSize -= !oddDivisor[0];
+	}
+
+	const size_t size = remainderSize - divSize + 1;
+
+	result.clear();
+	result.resize(size);
+
+	rdivexact(rptr(result), remainderEnd, size, divEnd, divSize, inverse(*divEnd));
+
+	if(!result.front())
+		result.erase(result.begin());
+
+	return numMinExp + exp_t(result.size());
+}
+
+
+// Cancels the greatest common divisor out of integer vectors left and right, and returns false if they are coprime
+//     the reduced vectors are stored into leftResult and rightResult together with their exponents
+static bool cancel(data_t &leftResult, exp_t &leftExp, const data_t &left,
+				   data_t &rightResult, exp_t &rightExp, const data_t &right)
+{
+	data_t common;
+	gcd(common, left, right);
+
+	if(isOne(common))
+		return false;
+
+	leftExp = divideExact(leftResult, leftExp, left, common);
+	rightExp = divideExact(rightResult, rightExp, right, common);
+
+	return true;
+}
+
+
+// Reads a non-zero number as integer vectors nom / den, with the scale of the value in chunks moved onto one of them
+static void toIntegers(data_t &nom, data_t &den, const number &num)
+{
+	nom = num.nom();
+	den = num.den();
+
+	const exp_t
+			nomExp = truncate(num.nomExp(), nom),
+			denExp = truncate(num.denExp(), den),
+			scale = minExp(nomExp, nom) - minExp(denExp, den);
+
+	if(scale > 0)
+		nom.resize(nom.size() + size_t(scale));
+	else
+		den.resize(den.size() + size_t(-scale));
+}
+
+
+// Rounds integer vector vec to its size most significant chunks, to nearest with ties to even, and returns the number
+// of chunks cut off its end
+//     sticky is set when the value continues below the vector, a carry out of the kept chunks grows the vector
+static size_t roundInteger(data_t &vec, size_t size, bool sticky)
+{
+	if(vec.size() <= size)
+		return 0;
+
+	constexpr num_t half = num_t(1) << (number::ChunkBits - 1);
+
+	const size_t dropped = vec.size() - size;
+	const num_t first = vec[size];
+
+	sticky |= (first & (half - 1)) || std::any_of(vec.begin() + size + 1, vec.end(), [](const auto &value) { return value; });
+
+	const bool up = (first & half) && (sticky || (vec[size - 1] & 1));
+
+	vec.resize(size);
+
+	if(up)
+		increment(vec, 1);
+
+	return dropped;
+}
+
+
+
+//-MODULAR-ARITHMETIC-FUNCTIONS----------------------------------------------------------------------------------------
+//    Powers modulo an integer vector are computed over residues padded to the size of the modulus, so the operands
+//    never grow past it, odd moduli keep the residues in Montgomery form and need no division between the steps
+
+
+// Reads a number as an integer vector, and returns false if it is not an integer
+static bool toInteger(data_t &vec, const number &num)
+{
+	if(num.isZero()) {
+		vec.clear();
+		return true;
+	}
+
+	data_t nom, den, remainder;
+
+	toIntegers(nom, den, num);
+	divide(vec, remainder, nom, den);
+
+	return remainder.empty();
+}
+
+
+// Multiplication of residues x * B^size mod m in Montgomery form, for an odd modulus m of size chunks
+//     The product of two residues is divided by B^size, after a multiple of m that clears its lower chunks is added one
+//     chunk at a time, which leaves it below 2 * m
+
+class Montgomery {
+	const data_t &m_modulus;
+	const num_t m_inverse;
+
+	const Scratch<> m_product;
+
+public:
+	explicit Montgomery(const data_t &modulus) :
+			m_modulus{modulus},
+			m_inverse{num_t(0u - inverse(modulus.back()))},
+			m_product(2 * modulus.size() + 1) {}
+
+	// Residues are buffers of the size of the modulus, dest can be one of the operands
+	void operator()(num_t *dest, const num_t *left, const num_t *right) const
+	{
+		const size_t size = m_modulus.size();
+		num_t *const product = m_product.data();
+
+		product[0] = 0;
+		rproduct(product + 2 * size, left + size - 1, size, right + size - 1, size);
+
+		num_t carry = 0;
+
+		for(size_t index = 0; index < size; ++index) {
+			num_t *const low = product + 2 * size - index;
+
+			const num_t overflow = rmuladd(low, rptr(m_modulus), size, num_t(*low * m_inverse));
+			const result_t sum = result_t(*(low - size)) + overflow + carry;
+
+			*(low - size) = num_t(sum & number::ResultMask);
+			carry = num_t(sum >> number::OverflowOffset);
+		}
+
+		product[0] = carry;
+
+		if(carry || rcmp(product + size, rptr(m_modulus), size) >= 0)
+			rdiff(product + size, rptr(m_modulus), size);
+
+		std::copy(product + 1, product + size + 1, dest);
+	}
+
+	// Moves residue x of an integer vector below the modulus into the form as x * B^size mod m into dest
+	void toForm(num_t *dest, const data_t &vec) const
+	{
+		data_t shifted = vec, quotient, remainder;
+
+		shifted.resize(vec.size() + m_modulus.size());
+		divide(quotient, remainder, shifted, m_modulus);
+
+		std::fill(dest, dest + m_modulus.size() - remainder.size(), 0);
+		std::copy(remainder.begin(), remainder.end(), dest + m_modulus.size() - remainder.size());
+	}
+
+	// Moves a residue out of the form into integer vector vec
+	void fromForm(data_t &vec, const num_t *residue) const
+	{
+		vec.assign(m_modulus.size(), 0);
+		vec.back() = 1;
+
+		(*this)(vec.data(), residue, vec.data());
+		trimFront(vec);
+	}
+};
+
+
+// Multiplication of residues modulo any modulus m, where each product is divided by m
+class Remainders {
+	const data_t &m_modulus;
+
+	mutable data_t m_product, m_quotient, m_remainder;
+
+public:
+	explicit Remainders(const data_t &modulus) : m_modulus{modulus} {}
+
+	// Residues are buffers of the size of the modulus, dest can be one of the operands
+	void operator()(num_t *dest, const num_t *left, const num_t *right) const
+	{
+		const size_t size = m_modulus.size();
+
+		m_product.resize(2 * size);
+		rproduct(rptr(m_product), left + size - 1, size, right + size - 1, size);
+		trimFront(m_product);
+
+		divide(m_quotient, m_remainder, m_product, m_modulus);
+
+		std::fill(dest, dest + size - m_remainder.size(), 0);
+		std::copy(m_remainder.begin(), m_remainder.end(), dest + size - m_remainder.size());
+	}
+};
+
+
+// Raises a residue base of size chunks to power exp > 0 into result, with multiply as the multiplication of residues
+//     A fixed window takes width bits of exp at a time, so each width squares are followed by at most one multiplication
+//     by a power of the base from a table
+
+template<typename Multiply>
+static void windowPower(num_t *result, const num_t *base, size_t size, const data_t &exp, const Multiply &multiply)
+{
+	const auto bits = size_t(bitLength(exp_t(exp.size()), exp));
+
+	// A wider window saves multiplications in the scan, but doubles the table
+	const digits_t width = bits > 672 ? 6 : bits > 240 ? 5 : bits > 80 ? 4 : bits > 24 ? 3 : bits > 8 ? 2 : 1;
+
+	// Bits [position, position + count) of exp, where count < ChunkBits
+	const auto window = [&exp](size_t position, digits_t count) {
+		size_t value = 0;
+
+		for(size_t bit = position + count; bit-- > position;) {
+			const num_t chunk = exp[exp.size() - 1 - bit / number::ChunkBits];
+			value = 2 * value + ((chunk >> (bit % number::ChunkBits)) & 1u);
+		}
+
+		return value;
+	};
+
+	// Table holds base^index for index from 1, at offset (index - 1) * size
+	const size_t entries = (size_t(1) << width) - 1;
+	const Scratch<> table(entries * size);
+
+	std::copy(base, base + size, table.data());
+
+	for(size_t index = 1; index < entries; ++index)
+		multiply(table.data() + index * size, table.data() + (index - 1) * size, base);
+
+	// The top window is shorter when width does not divide the bits, and it is never zero
+	size_t position = bits - ((bits - 1) % width + 1);
+	const size_t top = window(position, digits_t(bits - position));
+
+	std::copy(table.data() + (top - 1) * size, table.data() + top * size, result);
+
+	while(position) {
+		position -= width;
+
+		for(digits_t square = 0; square < width; ++square)
+			multiply(result, result, result);
+
+		if(const size_t index = window(position, width))
+			multiply(result, result, table.data() + (index - 1) * size);
+	}
+}
+
+
+//-RADIX-CONVERSION-FUNCTIONS------------------------------------------------------------------------------------------
+//    Integer vectors are converted from and to strings of digits by splitting them in halves at powers of the radix,
+//    so the conversions run at the speed of the multiplication, and only the small parts go one chunk at a time
+
+
+// Size in chunks up to which integer vectors are converted one chunk of digits at a time
+static constexpr size_t RadixSplitThreshold = 32;
+
+static constexpr char DigitCharacters[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+
+// Returns the value of a digit character, or radix if it is not a digit of the radix
+static unsigned digitValue(char digit, unsigned radix) noexcept
+{
+	unsigned value = radix;
+
+	if(digit >= '0' && digit <= '9')
+		value = unsigned(digit - '0');
+	else if(digit >= 'a' && digit <= 'z')
+		value = unsigned(digit - 'a') + 10;
+	else if(digit >= 'A' && digit <= 'Z')
+		value = unsigned(digit - 'A') + 10;
+
+	return value < radix ? value : radix;
+}
+
+
+// Powers of the radix cached for a conversion, where the power at level k is group^(2^k)
+class RadixPowers {
+	std::vector<data_t> m_powers, m_reciprocals;
+	std::vector<exp_t> m_reciprocalExps;
+
+public:
+	const unsigned radix;
+
+	// Number of digits that fit into a chunk, and the value of the radix to them
+	digits_t groupDigits = 0;
+	num_t group = 1;
+
+	explicit RadixPowers(unsigned base) :
+			radix{base}
+	{
+		for(result_t value = radix; value <= number::ResultMask; value *= radix) {
+			group = num_t(value);
+			++groupDigits;
+		}
+
+		m_powers.push_back({group});
+	}
+
+	const data_t &power(size_t level)
+	{
+		while(m_powers.size() <= level) {
+			const data_t &last = m_powers.back();
+
+			data_t square;
+			multiplyIntegers(square, last, last);
+
+			m_powers.push_back(std::move(square));
+		}
+
+		return m_powers[level];
+	}
+
+	// Reciprocal of the power for divisions with quotients of up to the size of the power
+	const data_t &reciprocal(size_t level, exp_t &exp)
+	{
+		while(m_reciprocals.size() <= level) {
+			const data_t &divisor = power(m_reciprocals.size());
+
+			data_t inverse;
+			const auto bits = digits_t((divisor.size() + 1) * number::ChunkBits);
+
+			m_reciprocalExps.push_back(::reciprocal(inverse, exp_t(divisor.size()), divisor, bits));
+			m_reciprocals.push_back(std::move(inverse));
+		}
+
+		exp = m_reciprocalExps[level];
+		return m_reciprocals[level];
+	}
+};
+
+
+// Reads count valid digits into integer vector result, where count > 0
+static void readDigits(data_t &result, const char *digits, size_t count, RadixPowers &powers)
+{
+	const size_t groupDigits = powers.groupDigits;
+
+	if(count > groupDigits * RadixSplitThreshold) {
+		// The lower part takes the digits of the biggest power below the count
+		size_t level = 0, lowCount = groupDigits;
+
+		while(2 * lowCount < count) {
+			lowCount *= 2;
+			++level;
+		}
+
+		data_t high, low;
+		readDigits(high, digits, count - lowCount, powers);
+		readDigits(low, digits + (count - lowCount), lowCount, powers);
+
+		// result = high * power + low
+		if(high.empty()) {
+			result = std::move(low);
+			return;
+		}
+
+		const data_t &power = powers.power(level);
+		multiplyIntegers(result, high, power);
+
+		if(!low.empty()) {
+			pushFront(result, 0);
+			rcarry(rptr(result) - low.size(), result.size() - low.size(), num_t(rsum(rptr(result), rptr(low), low.size())));
+			trimFront(result);
+		}
+
+		return;
+	}
+
+	result.clear();
+
+	const char *const end = digits + count;
+
+	// The first group takes the remaining digits, so that all the others are whole
+	for(const char *next = digits + (count - 1) % groupDigits + 1; digits != end; next += groupDigits) {
+		result_t value = 0;
+
+		for(; digits != next; ++digits)
+			value = value * powers.radix + digitValue(*digits, powers.radix);
+
+		// result = result * group + value
+		for(auto chunk = result.rbegin(); chunk != result.rend(); ++chunk) {
+			value += result_t(*chunk) * powers.group;
+			*chunk = num_t(value & number::ResultMask);
+			value >>= number::OverflowOffset;
+		}
+
+		if(value)
+			pushFront(result, num_t(value));
+	}
+}
+
+
+
+// Writes integer vector num as the groupDigits * 2^(level + 1) digits that end at end, where num < power(level)^2
+//     num is destroyed, and the powers of the level have to be built with their reciprocals beforehand
+
+static void writeDigits(char *end, data_t &num, size_t level, RadixPowers &powers)
+{
+	const size_t width = size_t(powers.groupDigits) << (level + 1);
+
+	if(num.size() <= RadixSplitThreshold) {
+		char *digit = end;
+
+		while(!num.empty()) {
+			num_t remainder = rdiv(rptr(num), rptr(num), num.size(), powers.group);
+			trimFront(num);
+
+			for(digits_t index = 0; index < powers.groupDigits; ++index) {
+				*--digit = DigitCharacters[remainder % powers.radix];
+				remainder /= powers.radix;
+			}
+		}
+
+		std::fill(end - width, digit, '0');
+		return;
+	}
+
+	// The quotient and the remainder by the power are the upper and the lower half of the digits
+	exp_t inverseExp;
+	const data_t &inverse = powers.reciprocal(level, inverseExp);
+
+	data_t quotient, remainder;
+	divide(quotient, remainder, num, powers.power(level), inverseExp, inverse);
+
+	writeDigits(end - width / 2, quotient, level - 1, powers);
+	writeDigits(end, remainder, level - 1, powers);
+}
+
+
+// Returns the digits of integer vector num without leading zeros
+//     num is destroyed
+
+static std::string toDigits(data_t &num, RadixPowers &powers)
+{
+	if(num.empty())
+		return "0";
+
+	// The power of the top level squared is bigger than num
+	size_t level = 0;
+
+	while(2 * powers.power(level).size() < num.size() + 2)
+		++level;
+
+	if(num.size() > RadixSplitThreshold) {
+		exp_t inverseExp;
+		powers.reciprocal(level, inverseExp);
+	}
+
+	std::string digits(size_t(powers.groupDigits) << (level + 1), '0');
+	writeDigits(digits.data() + digits.size(), num, level, powers);
+
+	digits.erase(0, digits.find_first_not_of('0'));
+	return digits;
+}
+
+
+// Divides the factors prime out of integer vector vec, at most limit of them, and returns how many were divided out
+static uexp_t removeFactor(data_t &vec, num_t prime, uexp_t limit)
+{
+	// The biggest power of the prime in a chunk takes many of them at once
+	num_t power = prime;
+	uexp_t powerCount = 1;
+
+	for(; power <= number::ResultMask / prime; power = num_t(power * prime))
+		++powerCount;
+
+	uexp_t count = 0;
+
+	for(bool whole = true; count < limit;) {
+		whole = whole && limit - count >= powerCount;
+
+		const num_t div = whole ? power : prime;
+
+		if(rmod(rptr(vec), vec.size(), div)) {
+			if(!whole)
+				break;
+
+			whole = false;
+			continue;
+		}
+
+		rdiv(rptr(vec), rptr(vec), vec.size(), div);
+		trimFront(vec);
+
+		count += whole ? powerCount : 1;
+	}
+
+	return count;
+}
+
+
+
+//-NUMBER-ARITHMETIC-PRELIMINARY-CHECKS--------------------------------------------------------------------------------
+//    These functions Are run before the actual computation to do bound checking, and return true if they pass
+//    If they return false, they MUST set the result and that value will be returned
+
+// AddPositive and SubPositive operate on magnitudes, so values passed through keep only their magnitude
+static number abs(const number &num)
+{
+	return num.sign() == Sign::Positive ? num : -num;
+}
+
+static bool checkAdd(number &result, const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(leftUndef | rightUndef)
+		result = number::Undefined();
+	else if(leftZero)
+		result = abs(right);
+	else if(rightZero)
+		result = abs(left);
+	else if(leftNan | rightNan)
+		result = number::NaN();
+	else
+		return true;
+	return false;
 }
 
 static bool checkSub(number &result, const number &left, const number &right)
@@ -423,318 +3495,1605 @@ static bool checkSub(number &result, const number &left, const number &right)
 			leftZero = left.isZero(),
 			rightZero = right.isZero();
 
-	if(leftUndef | rightUndef)
-		result = number::Undefined();
-	else if(leftZero)
-		result = -right;
-	else if(rightZero)
-		result = left;
-	else if(leftNan | rightNan)
-		result = number::NaN();
+	if(leftUndef | rightUndef)
+		result = number::Undefined();
+	else if(leftZero)
+		result = abs(right).negate();
+	else if(rightZero)
+		result = abs(left);
+	else if(leftNan | rightNan)
+		result = number::NaN();
+	else
+		return true;
+	return false;
+}
+
+static bool checkMultiply(number &result, const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(leftUndef | rightUndef | (leftNan & rightZero) | (rightNan & leftZero))
+		result = number::Undefined();
+	else if(leftZero | rightZero)
+		result = number::Zero();
+	else if(leftNan | rightNan)
+		result = number::NaN();
+	else
+		return true;
+	return false;
+}
+
+static bool checkDivide(number &result, const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(leftUndef | rightUndef | (leftNan & rightNan) | (leftZero & rightZero))
+		result = number::Undefined();
+	else if(leftZero | rightNan)
+		result = number::Zero();
+	else if(leftNan | rightZero)
+		result = number::NaN();
+	else
+		return true;
+	return false;
+}
+
+static bool checkPower(number &result, const number &num, exp_t exp)
+{
+	const bool
+			undef = num.isUndefined(),
+			nan = num.isNaN(),
+			zero = num.isZero();
+
+	if(undef | zero | nan)
+		result = num;
+	else if(!exp)
+		result = number::One();
+	else
+		return true;
+	return false;
+}
+
+static bool checkSqrt(number &result, const number &num)
+{
+	const bool
+			undef = num.isUndefined(),
+			nan = num.isNaN(),
+			zero = num.isZero();
+
+	if(undef)
+		result = number::Undefined();
+	else if(zero)
+		result = number::Zero();
+	else if(nan | (num.sign() == Sign::Negative))
+		result = number::NaN();
+	else
+		return true;
+	return false;
+}
+
+
+
+static bool checkRound(number &result, const number &num)
+{
+	const bool
+			undef = num.isUndefined(),
+			nan = num.isNaN(),
+			zero = num.isZero();
+
+	if(undef | zero | nan)
+		result = num;
+	else
+		return true;
+	return false;
+}
+
+static bool checkPowMod(number &result, const number &base, const number &exp, const number &modulus)
+{
+	const bool
+			undef = base.isUndefined() | exp.isUndefined() | modulus.isUndefined(),
+			nan = base.isNaN() | exp.isNaN() | modulus.isNaN(),
+			modulusZero = modulus.isZero();
+
+	if(undef | modulusZero)
+		result = number::Undefined();
+	else if(nan | (exp.sign() == Sign::Negative) | (modulus.sign() == Sign::Negative))
+		result = number::NaN();
+	else
+		return true;
+	return false;
+}
+
+static bool checkRemainder(number &result, const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(leftUndef | rightUndef | leftNan | rightZero)
+		result = number::Undefined();
+	else if(leftZero)
+		result = number::Zero();
+	else if(rightNan)
+		result = left;
+	else
+		return true;
+	return false;
+}
+
+//-COMPARISON-PRELIMINARY-CHECKS---------------------------------------------------------------------------------------
+//    These functions Are run before the actual computation to do bound checking, and return true if they pass
+
+enum ComparisonCheckResult {
+	Fail = false,
+	Pass = true,
+	Compare
+};
+
+static ComparisonCheckResult checkEqual(const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftSign = left.sign(),
+			rightSign = right.sign(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(leftUndef | rightUndef)
+		return Fail;
+	else if((leftNan && rightNan) || (leftZero && rightZero))
+		return Pass;
+	else if(leftNan | rightNan | leftZero | rightZero | (leftSign != rightSign))
+		return Fail;
+	return Compare;
+}
+
+static ComparisonCheckResult checkLess(const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftSign = left.sign(),
+			rightSign = right.sign(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	// Zero has no sign, and NaN has no order
+	if(leftUndef | rightUndef | leftNan | rightNan | (leftZero && rightZero))
+		return Fail;
+	else if(leftZero)
+		return rightSign == Sign::Positive ? Pass : Fail;
+	else if(rightZero | (leftSign != rightSign))
+		return leftSign == Sign::Negative ? Pass : Fail;
+	return Compare;
+}
+
+static ComparisonCheckResult checkMore(const number &left, const number &right)
+{
+	const bool
+			leftUndef = left.isUndefined(),
+			rightUndef = right.isUndefined(),
+			leftSign = left.sign(),
+			rightSign = right.sign(),
+			leftNan = left.isNaN(),
+			rightNan = right.isNaN(),
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	// Zero has no sign, and NaN has no order
+	if(leftUndef | rightUndef | leftNan | rightNan | (leftZero && rightZero))
+		return Fail;
+	else if(leftZero)
+		return rightSign == Sign::Negative ? Pass : Fail;
+	else if(rightZero | (leftSign != rightSign))
+		return leftSign == Sign::Positive ? Pass : Fail;
+	return Compare;
+}
+
+
+
+// Compares the magnitudes of non-zero numbers left and right through their cross products
+static int compareCross(const number &left, const number &right)
+{
+	if(isWord(left) & isWord(right))
+		return compareWords(toWord(left), toWord(right));
+
+	const bool truncated = left.nom().front() && left.den().front() && right.nom().front() && right.den().front();
+
+	// The magnitude lies between 2^(order - 1) and 2^(order + 1), so orders further apart decide on their own
+	if(truncated) {
+		const exp_t
+				leftOrder = bitLength(left.nomExp(), left.nom()) - bitLength(left.denExp(), left.den()),
+				rightOrder = bitLength(right.nomExp(), right.nom()) - bitLength(right.denExp(), right.den());
+
+		if(leftOrder + 1 < rightOrder)
+			return -1;
+		else if(rightOrder + 1 < leftOrder)
+			return 1;
+	}
+
+	return compareProducts(left.nomExp(), left.nom(), right.denExp(), right.den(),
+						   right.nomExp(), right.nom(), left.denExp(), left.den());
+}
+
+// Compares the magnitude of a non-zero number with a non-zero chunk, the same way as compareCross with value / 1
+static int compareChunk(const number &num, num_t value)
+{
+	if(isWord(num))
+		return compareWords(toWord(num), {value, 1});
+
+	// Single chunk vectors stay in the inline storage of the vectors
+	const data_t chunk{value}, one{1};
+
+	if(num.nom().front() && num.den().front()) {
+		const exp_t
+				order = bitLength(num.nomExp(), num.nom()) - bitLength(num.denExp(), num.den()),
+				chunkOrder = bitLength(0, chunk) - bitLength(0, one);
+
+		if(order + 1 < chunkOrder)
+			return -1;
+		else if(chunkOrder + 1 < order)
+			return 1;
+	}
+
+	return compareProducts(num.nomExp(), num.nom(), 0, one, 0, chunk, num.denExp(), num.den());
+}
+
+// Orders left and right by their signs, and by the magnitudes of non-zero numbers of the same sign
+static int compareOrder(const number &left, const number &right)
+{
+	const bool
+			leftZero = left.isZero(),
+			rightZero = right.isZero();
+
+	if(left.isUndefined() | right.isUndefined() | left.isNaN() | right.isNaN())
+		return number::Unordered;
+	else if(leftZero & rightZero)
+		return 0;
+	else if(leftZero)
+		return right.sign() == Sign::Positive ? -1 : 1;
+	else if(rightZero | (left.sign() != right.sign()))
+		return left.sign() == Sign::Positive ? 1 : -1;
+
+	const int order = compareCross(left, right);
+
+	return left.sign() == Sign::Positive ? order : -order;
+}
+
+
+
+//-CONSTRUCTORS--------------------------------------------------------------------------------------------------------
+
+number::number(int value) :
+		m_nom{num_t(IntegerMagnitude(value))},
+		m_den{1},
+		m_sign{IntegerSign(value)},
+		m_canonical{true}
+{
+	if(!value)
+		m_nom.clear();
+}
+
+number::number(Sign sign, exp_t nomExp, data_t &&nom, exp_t denExp, data_t &&den) noexcept :
+		m_nom{std::move(nom)},
+		m_den{std::move(den)},
+		m_nomExp{truncate(nomExp, m_nom)},
+		m_denExp{truncate(denExp, m_den)},
+		m_sign{sign} {}
+
+
+
+number::number(std::string_view text, unsigned radix) :
+		number(NaN())
+{
+	if((radix < 2) | (radix > 36))
+		return;
+
+	const bool negative = !text.empty() && text.front() == '-';
+
+	if(!text.empty() && (text.front() == '-' || text.front() == '+'))
+		text.remove_prefix(1);
+
+	const size_t point = text.find('.');
+
+	std::string_view
+			whole = text.substr(0, point),
+			fraction = point == std::string_view::npos ? std::string_view() : text.substr(point + 1);
+
+	const auto isDigit = [radix](char digit) { return digitValue(digit, radix) < radix; };
+
+	if((whole.empty() & fraction.empty()) ||
+	   !std::all_of(whole.begin(), whole.end(), isDigit) ||
+	   !std::all_of(fraction.begin(), fraction.end(), isDigit))
+		return;
+
+	// Trailing zeros of the fraction are only factors of the radix
+	while(!fraction.empty() && fraction.back() == '0')
+		fraction.remove_suffix(1);
+
+	std::string digits;
+	digits.reserve(whole.size() + fraction.size());
+	digits.append(whole).append(fraction);
+
+	RadixPowers powers(radix);
+	data_t nom, den = {1};
+
+	if(!digits.empty())
+		readDigits(nom, digits.data(), digits.size(), powers);
+
+	if(nom.empty()) {
+		*this = Zero();
+		return;
+	}
+
+	// The value is nom / radix^fraction, where the nominator can share only the prime factors of the radix
+	for(unsigned prime = 2, rest = radix; rest > 1; ++prime) {
+		uexp_t count = 0;
+
+		for(; rest % prime == 0; rest /= prime)
+			count += fraction.size();
+
+		if(count) {
+			count -= removeFactor(nom, prime, count);
+
+			if(count) {
+				data_t factor, product;
+
+				integerPart(factor, ::power(factor, 1, data_t{prime}, count));
+				multiplyIntegers(product, den, factor);
+
+				den = std::move(product);
+			}
+		}
+	}
+
+	m_nomExp = truncate(exp_t(nom.size()), nom);
+	m_denExp = truncate(exp_t(den.size()), den);
+	m_nom = std::move(nom);
+	m_den = std::move(den);
+	m_sign = !negative;
+
+	canonicalize();
+	m_canonical = true;
+}
+
+
+
+//-OPERATORS-----------------------------------------------------------------------------------------------------------
+
+number number::operator-() const &
+{
+	number result = *this;
+	result.negate();
+	return result;
+}
+
+number number::operator-() &&
+{
+	negate();
+	return std::move(*this);
+}
+
+number &number::operator+=(const number &other)
+{
+	// Same cases as in operator+, with this number as the left operand
+	if(sign() == Positive) {
+		if(other.sign() == Positive)
+			assignAddPositive(*this, other);
+		else
+			assignSubPositive(*this, other);
+	}
+	else {
+		if(other.sign() == Positive)
+			assignSubPositive(other, *this);
+		else {
+			assignAddPositive(*this, other);
+			negate();
+		}
+	}
+
+	return *this;
+}
+
+number &number::operator-=(const number &other)
+{
+	// Same cases as in operator-, with this number as the left operand
+	if(sign() == Positive) {
+		if(other.sign() == Positive)
+			assignSubPositive(*this, other);
+		else
+			assignAddPositive(*this, other);
+	}
+	else {
+		if(other.sign() == Positive) {
+			assignAddPositive(*this, other);
+			negate();
+		}
+		else
+			assignSubPositive(other, *this);
+	}
+
+	return *this;
+}
+
+number &number::operator*=(const number &other)
+{
+	assignMultiply(*this, other);
+	return *this;
+}
+
+number &number::operator/=(const number &other)
+{
+	assignDivide(*this, other);
+	return *this;
+}
+
+
+
+//-CONVERSION-MEMBER-FUNCTIONS-----------------------------------------------------------------------------------------
+
+std::string number::toString(digits_t digits, unsigned radix) const
+{
+	if((radix < 2) | (radix > 36))
+		return {};
+	else if(isUndefined())
+		return "undefined";
+	else if(isNaN())
+		return "nan";
+
+	data_t nom, den, quotient, remainder;
+
+	if(isNonZero()) {
+		toIntegers(nom, den, *this);
+
+		// Digits after the point are shifted in front of it
+		if(digits) {
+			data_t shift, shifted;
+
+			integerPart(shift, ::power(shift, 1, data_t{num_t(radix)}, digits));
+			multiplyIntegers(shifted, nom, shift);
+
+			nom = std::move(shifted);
+		}
+
+		divide(quotient, remainder, nom, den);
+	}
+
+	const bool negative = !m_sign && !quotient.empty();
+
+	RadixPowers powers(radix);
+	std::string text = toDigits(quotient, powers);
+
+	if(text.size() <= digits)
+		text.insert(0, digits + 1 - text.size(), '0');
+
+	if(digits)
+		text.insert(text.size() - digits, 1, '.');
+
+	if(negative)
+		text.insert(0, 1, '-');
+
+	return text;
+}
+
+
+
+//-ARITHMETIC-MEMBER-FUNCTIONS-----------------------------------------------------------------------------------------
+
+number number::power(exp_t exp) const
+{
+	return Power(*this, exp);
+}
+
+number number::powmod(const number &exp, const number &modulus) const
+{
+	return PowMod(*this, exp, modulus);
+}
+
+number number::sqrt(digits_t bits) const
+{
+	return Sqrt(*this, bits);
+}
+
+number number::floor() const
+{
+	return Floor(*this);
+}
+
+number number::trunc() const
+{
+	return Trunc(*this);
+}
+
+number &number::normalize()
+{
+	if(isNonZero() & isNotNaN()) {
+		m_nomExp = truncate(m_nomExp, m_nom);
+		m_denExp = truncate(m_denExp, m_den);
+
+		if(m_nom.empty()) {
+			*this = Zero();
+			return *this;
+		}
+
+		if(cancel(spare.nom, m_nomExp, m_nom, spare.den, m_denExp, m_den)) {
+			swapIn(m_nom, spare.nom);
+			swapIn(m_den, spare.den);
+		}
+
+		canonicalize();
+		m_canonical = true;
+		m_reducedSize = m_nom.size() + m_den.size();
+	}
+
+	return *this;
+}
+
+
+
+//-INTERNAL-HELPER-METHODS---------------------------------------------------------------------------------------------
+
+number number::Integer(Sign sign, data_t &&vec)
+{
+	if(vec.empty())
+		return Zero();
+
+	number result(sign, exp_t(vec.size()) - 1, std::move(vec), DefaultExponent, data_t{1});
+	result.m_canonical = true;
+
+	return result;
+}
+
+number number::Integer(Sign sign, uint64_t magnitude)
+{
+	data_t vec;
+
+	// Chunks of the magnitude from the most significant
+	for(digits_t shift = 64; shift;) {
+		shift -= ChunkBits;
+		vec.push_back(num_t(magnitude >> shift));
+	}
+
+	trimFront(vec);
+
+	return Integer(sign, std::move(vec));
+}
+
+data_t number::CommonDenominator(exp_t &denExp, data_t &den,
+								 exp_t &leftExp, data_t &leftNormal,
+								 exp_t &rightExp, data_t &rightNormal,
+								 const number &left, const number &right)
+{
+	data_t common, leftFactor, rightFactor;
+
+	exp_t
+			leftFactorExp = right.m_denExp,
+			rightFactorExp = left.m_denExp;
+
+	const data_t
+			*leftMultiplier = &right.m_den,
+			*rightMultiplier = &left.m_den;
+
+	// With the gcd divided out, each nominator is multiplied only by the part of the other denominator it lacks
+	if(reduction() == Reduction::Always) {
+		gcd(common, left.m_den, right.m_den);
+
+		if(isOne(common))
+			common.clear();
+		else {
+			leftFactorExp = divideExact(leftFactor, leftFactorExp, right.m_den, common);
+			rightFactorExp = divideExact(rightFactor, rightFactorExp, left.m_den, common);
+
+			leftMultiplier = &leftFactor;
+			rightMultiplier = &rightFactor;
+		}
+	}
+
+	leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, leftFactorExp, *leftMultiplier);
+	rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, rightFactorExp, *rightMultiplier);
+
+	denExp = multiply(den, left.m_denExp, left.m_den, leftFactorExp, *leftMultiplier);
+
+	return common;
+}
+
+void number::reduce(const data_t &common)
+{
+	// Nominators cancelled each other out
+	if(m_nom.empty()) {
+		*this = Zero();
+		return;
+	}
+
+	// The sum of nominators can share only factors of the denominator gcd with the common denominator
+	if(!common.empty()) {
+		data_t factor;
+		gcd(factor, m_nom, common);
+
+		if(!isOne(factor)) {
+			m_nomExp = divideExact(spare.nom, m_nomExp, m_nom, factor);
+			m_denExp = divideExact(spare.den, m_denExp, m_den, factor);
+
+			swapIn(m_nom, spare.nom);
+			swapIn(m_den, spare.den);
+		}
+	}
+
+	finish();
+}
+
+void number::canonicalize()
+{
+	// Scale of the value in chunks, when the nominator and the denominator are read as integers
+	exp_t scale = minExp(m_nomExp, m_nom) - minExp(m_denExp, m_den);
+
+	const digits_t
+			nomZeros = trailingZeros(m_nom.back()),
+			denZeros = trailingZeros(m_den.back()),
+			commonZeros = std::min(nomZeros, denZeros);
+
+	shiftRight(m_nom, commonZeros);
+	shiftRight(m_den, commonZeros);
+
+	// A chunk of the scale cancels the binary factor left on the other side, at most one side has one
+	if(scale > 0 && denZeros > commonZeros) {
+		shiftRight(m_den, denZeros - commonZeros);
+		shiftLeft(m_nom, ChunkBits - (denZeros - commonZeros));
+		--scale;
+	}
+	else if(scale < 0 && nomZeros > commonZeros) {
+		shiftRight(m_nom, nomZeros - commonZeros);
+		shiftLeft(m_den, ChunkBits - (nomZeros - commonZeros));
+		++scale;
+	}
+
+	m_denExp = DefaultExponent;
+	m_nomExp = scale + exp_t(m_nom.size()) - exp_t(m_den.size());
+}
+
+void number::finish()
+{
+	// Rounded results are canonical under any policy
+	if(precision()) {
+		roundToPrecision();
+		return;
+	}
+
+	switch(reduction()) {
+		case Reduction::Never:
+			m_canonical = false;
+			break;
+
+		// Reduction is repeated once the value doubles in size, so its cost is spread over the operations that grew it
+		case Reduction::Lazy:
+			if(m_nom.size() + m_den.size() > std::max(LazyReductionSize, 2 * m_reducedSize))
+				normalize();
+			else
+				m_canonical = false;
+			break;
+
+		// Only the cross factors are cancelled, so the result is reduced only if the operands were
+		case Reduction::Always:
+			canonicalize();
+			m_reducedSize = m_nom.size() + m_den.size();
+			break;
+	}
+}
+
+void number::roundToPrecision()
+{
+	const size_t budget = precision();
+
+	m_nomExp = truncate(m_nomExp, m_nom);
+	m_denExp = truncate(m_denExp, m_den);
+
+	if(m_nom.empty()) {
+		*this = Zero();
+		return;
+	}
+
+	// Scale of the value in chunks, when the nominator and the denominator are read as integers
+	exp_t scale = minExp(m_nomExp, m_nom) - minExp(m_denExp, m_den);
+	bool sticky = false;
+
+	// A binary denominator moves into the nominator a chunk lower, any other one is divided out into a quotient longer
+	// than the budget, whose remainder only tells whether the value continues below it
+	if((m_den.size() == 1) & !(m_den.front() & (m_den.front() - 1))) {
+		if(!isOne(m_den)) {
+			shiftLeft(m_nom, ChunkBits - trailingZeros(m_den.front()));
+			--scale;
+		}
+	}
+	else {
+		const size_t
+				length = budget + 1 + m_den.size(),
+				shift = length - std::min(length, m_nom.size());
+
+		spare.nom = m_nom;
+		spare.nom.resize(m_nom.size() + shift);
+
+		divide(spare.leftNom, spare.rightNom, spare.nom, m_den);
+
+		sticky = !spare.rightNom.empty();
+		swapIn(m_nom, spare.leftNom);
+		scale -= exp_t(shift);
+	}
+
+	scale += exp_t(roundInteger(m_nom, budget, sticky));
+
+	m_den.assign(1, 1);
+	m_nomExp = truncate(scale + exp_t(m_nom.size()), m_nom);
+	m_denExp = 1;
+
+	canonicalize();
+	m_canonical = true;
+}
+
+bool number::assignDominant(const number &left, const number &right, Sign rightSign)
+{
+	const size_t budget = precision();
+
+	// Rounded values have a binary denominator, which moves into the nominator when it is read as an integer
+	const auto isRounded = [budget](const number &num) {
+		const num_t den = num.m_den.front();
+		const bool overflows = (den != 1) && leadingZeros(num.m_nom.front()) < ChunkBits - trailingZeros(den);
+
+		return num.m_canonical && (num.m_den.size() == 1) && !(den & (den - 1)) &&
+			   num.m_nom.size() + overflows <= budget;
+	};
+
+	if(!budget || !isRounded(left) || !isRounded(right))
+		return false;
+
+	// An operand more than the budget and two chunks below the other one is under half of its last unit
+	const exp_t
+			leftOrder = bitLength(left.m_nomExp, left.m_nom) - bitLength(left.m_denExp, left.m_den),
+			rightOrder = bitLength(right.m_nomExp, right.m_nom) - bitLength(right.m_denExp, right.m_den),
+			gap = exp_t(budget + 2) * exp_t(ChunkBits);
+
+	if(leftOrder - rightOrder > gap) {
+		*this = left;
+		m_sign = Positive;
+	}
+	else if(rightOrder - leftOrder > gap) {
+		*this = right;
+		m_sign = rightSign;
+	}
 	else
-		return true;
-	return false;
+		return false;
+
+	return true;
 }
 
-static bool checkMultiply(number &result, const number &left, const number &right)
+void number::assignWord(Sign sign, num_t nom, num_t den)
 {
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+	if(!nom) {
+		*this = Zero();
+		return;
+	}
 
-	if(leftUndef | rightUndef | (leftNan & rightZero) | (rightNan & leftZero))
-		result = number::Undefined();
-	else if(leftZero | rightZero)
-		result = number::Zero();
-	else if(leftNan | rightNan)
-		result = number::NaN();
-	else
-		return true;
-	return false;
+	m_nom.assign(1, nom);
+	m_den.assign(1, den);
+	m_nomExp = DefaultExponent;
+	m_denExp = DefaultExponent;
+	m_sign = sign;
+	m_canonical = true;
+	m_reducedSize = 2;
+
+	if(precision())
+		roundToPrecision();
 }
 
-static bool checkDivide(number &result, const number &left, const number &right)
+void number::assignAddPositive(const number &left, const number &right)
 {
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+	if(checkAdd(*this, left, right)) {
+		Word word;
 
-	if(leftUndef | rightUndef | (leftNan & rightNan) | (leftZero & rightZero))
-		result = number::Undefined();
-	else if(leftZero | rightNan)
-		result = number::Zero();
-	else if(leftNan | rightZero)
-		result = number::NaN();
-	else
-		return true;
-	return false;
+		if(areCanonicalWords(left, right) && addWords(word, toWord(left), toWord(right))) {
+			assignWord(Positive, word.nom, word.den);
+			return;
+		}
+		else if(assignDominant(left, right, Positive))
+			return;
+
+		exp_t denExp, leftExp, rightExp;
+
+		const data_t common = CommonDenominator(denExp, spare.den,
+												leftExp, spare.leftNom, rightExp, spare.rightNom, left, right);
+
+		const exp_t nomExp = add(spare.nom, leftExp, spare.leftNom, rightExp, spare.rightNom);
+		const bool canonical = left.m_canonical & right.m_canonical;
+		const size_t reducedSize = std::max(left.m_reducedSize, right.m_reducedSize);
+
+		swapIn(m_nom, spare.nom);
+		swapIn(m_den, spare.den);
+
+		m_nomExp = nomExp;
+		m_denExp = denExp;
+		m_sign = Positive;
+		m_canonical = canonical;
+		m_reducedSize = reducedSize;
+		reduce(common);
+	}
 }
 
-static bool checkPower(number &result, const number &num, exp_t exp)
+void number::assignSubPositive(const number &left, const number &right)
 {
-	const bool
-			undef = num.isUndefined(),
-			nan = num.isNaN(),
-			zero = num.isZero();
+	if(checkSub(*this, left, right)) {
+		Word word;
+		Sign sign;
 
-	if(undef | zero | nan)
-		result = num;
-	else if(!exp)
-		result = number::One();
-	else
-		return true;
-	return false;
+		if(areCanonicalWords(left, right) && subWords(word, sign, toWord(left), toWord(right))) {
+			assignWord(sign, word.nom, word.den);
+			return;
+		}
+		else if(assignDominant(left, right, Negative))
+			return;
+
+		exp_t denExp, leftExp, rightExp;
+
+		const data_t common = CommonDenominator(denExp, spare.den,
+												leftExp, spare.leftNom, rightExp, spare.rightNom, left, right);
+
+		const SubResult subResult = sub(spare.nom, leftExp, spare.leftNom, rightExp, spare.rightNom);
+		const bool canonical = left.m_canonical & right.m_canonical;
+		const size_t reducedSize = std::max(left.m_reducedSize, right.m_reducedSize);
+
+		swapIn(m_nom, spare.nom);
+		swapIn(m_den, spare.den);
+
+		m_nomExp = subResult.exp;
+		m_denExp = denExp;
+		m_sign = subResult.sign;
+		m_canonical = canonical;
+		m_reducedSize = reducedSize;
+		reduce(common);
+	}
 }
 
-static bool checkSqrt(number &result, const number &num)
+void number::assignMultiply(const number &left, const number &right)
 {
-	const bool
-			undef = num.isUndefined(),
-			nan = num.isNaN(),
-			zero = num.isZero();
+	if(checkMultiply(*this, left, right)) {
+		Word word;
 
-	if(undef)
-		result = number::Undefined();
-	else if(zero)
-		result = number::Zero();
-	else if(nan)
-		result = number::NaN();
+		if(areCanonicalWords(left, right) && multiplyWords(word, toWord(left), toWord(right))) {
+			assignWord(Sign(left.m_sign == right.m_sign), word.nom, word.den);
+			return;
+		}
+
+		exp_t
+				leftNomExp = left.m_nomExp, leftDenExp = left.m_denExp,
+				rightNomExp = right.m_nomExp, rightDenExp = right.m_denExp;
+
+		data_t
+				&leftNom = spare.leftNom, &leftDen = spare.leftDen,
+				&rightNom = spare.rightNom, &rightDen = spare.rightDen;
+
+		// Factors shared across the fractions are cancelled before multiplication
+		const bool
+				cancelling = reduction() == Reduction::Always,
+				nomDenCancelled = cancelling && cancel(leftNom, leftNomExp, left.m_nom, rightDen, rightDenExp, right.m_den),
+				denNomCancelled = cancelling && cancel(leftDen, leftDenExp, left.m_den, rightNom, rightNomExp, right.m_nom);
+
+		const exp_t
+				nomExp = multiply(spare.nom,
+								  leftNomExp, nomDenCancelled ? leftNom : left.m_nom,
+								  rightNomExp, denNomCancelled ? rightNom : right.m_nom),
+				denExp = multiply(spare.den,
+								  leftDenExp, denNomCancelled ? leftDen : left.m_den,
+								  rightDenExp, nomDenCancelled ? rightDen : right.m_den);
+
+		const bool
+				sign = left.m_sign == right.m_sign,
+				canonical = left.m_canonical & right.m_canonical;
+		const size_t reducedSize = std::max(left.m_reducedSize, right.m_reducedSize);
+
+		swapIn(m_nom, spare.nom);
+		swapIn(m_den, spare.den);
+
+		m_nomExp = nomExp;
+		m_denExp = denExp;
+		m_sign = sign;
+		m_canonical = canonical;
+		m_reducedSize = reducedSize;
+		finish();
+	}
+}
+
+void number::assignDivide(const number &left, const number &right)
+{
+	if(checkDivide(*this, left, right)) {
+		Word word;
+
+		// Division multiplies by the reciprocal word
+		if(areCanonicalWords(left, right) && multiplyWords(word, toWord(left), {right.m_den.front(), right.m_nom.front()})) {
+			assignWord(Sign(left.m_sign == right.m_sign), word.nom, word.den);
+			return;
+		}
+
+		exp_t
+				leftNomExp = left.m_nomExp, leftDenExp = left.m_denExp,
+				rightNomExp = right.m_nomExp, rightDenExp = right.m_denExp;
+
+		data_t
+				&leftNom = spare.leftNom, &leftDen = spare.leftDen,
+				&rightNom = spare.rightNom, &rightDen = spare.rightDen;
+
+		// Factors shared across the fractions are cancelled before multiplication by the reciprocal
+		const bool
+				cancelling = reduction() == Reduction::Always,
+				nomsCancelled = cancelling && cancel(leftNom, leftNomExp, left.m_nom, rightNom, rightNomExp, right.m_nom),
+				densCancelled = cancelling && cancel(leftDen, leftDenExp, left.m_den, rightDen, rightDenExp, right.m_den);
+
+		const exp_t
+				nomExp = multiply(spare.nom,
+								  leftNomExp, nomsCancelled ? leftNom : left.m_nom,
+								  rightDenExp, densCancelled ? rightDen : right.m_den),
+				denExp = multiply(spare.den,
+								  leftDenExp, densCancelled ? leftDen : left.m_den,
+								  rightNomExp, nomsCancelled ? rightNom : right.m_nom);
+
+		const bool
+				sign = left.m_sign == right.m_sign,
+				canonical = left.m_canonical & right.m_canonical;
+		const size_t reducedSize = std::max(left.m_reducedSize, right.m_reducedSize);
+
+		swapIn(m_nom, spare.nom);
+		swapIn(m_den, spare.den);
+
+		m_nomExp = nomExp;
+		m_denExp = denExp;
+		m_sign = sign;
+		m_canonical = canonical;
+		m_reducedSize = reducedSize;
+		finish();
+	}
+}
+
+
+void number::assignAdd(const number &left, const number &right, Sign rightSign)
+{
+	// Same cases as in operator+, where the sign of right is rightSign
+	if(left.sign() == Positive) {
+		if(rightSign == Positive)
+			assignAddPositive(left, right);
+		else
+			assignSubPositive(left, right);
+	}
+	else {
+		if(rightSign == Positive)
+			assignSubPositive(right, left);
+		else {
+			assignAddPositive(left, right);
+			negate();
+		}
+	}
+}
+
+void number::assignAddInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	const bool same = left.m_sign == sign;
+
+	// Magnitudes wider than a chunk are added as numbers
+	if(magnitude > ResultMask) {
+		*this = left + Integer(sign, magnitude);
+		return;
+	}
+	else if(left.isUndefined() | left.isNaN() | !magnitude) {
+		*this = left;
+		return;
+	}
+	else if(left.isZero()) {
+		*this = Integer(sign, magnitude);
+		return;
+	}
+
+	const auto value = num_t(magnitude);
+	Word word;
+	Sign wordSign = Positive;
+
+	if(isWord(left) & left.m_canonical &&
+	   (same ? addWords(word, toWord(left), {value, 1}) : subWords(word, wordSign, toWord(left), {value, 1}))) {
+		assignWord(static_cast<Sign>(left.m_sign == wordSign), word.nom, word.den);
+		return;
+	}
+
+	// left + value = (nom + value * den) / den, where the nominator stays coprime with the denominator
+	const exp_t productExp = multiplyChunk(spare.rightNom, left.m_denExp, left.m_den, value);
+
+	exp_t nomExp;
+	Sign nomSign = Positive;
+
+	if(same)
+		nomExp = add(spare.nom, left.m_nomExp, left.m_nom, productExp, spare.rightNom);
+	else {
+		const SubResult subResult = sub(spare.nom, left.m_nomExp, left.m_nom, productExp, spare.rightNom);
+		nomExp = subResult.exp;
+		nomSign = subResult.sign;
+	}
+
+	if(this != &left) {
+		m_den = left.m_den;
+		m_denExp = left.m_denExp;
+	}
+
+	swapIn(m_nom, spare.nom);
+
+	m_nomExp = nomExp;
+	m_sign = left.m_sign == nomSign;
+	m_canonical = left.m_canonical;
+	m_reducedSize = left.m_reducedSize;
+	reduce(data_t{});
+}
+
+void number::assignMultiplyInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	if(magnitude > ResultMask) {
+		*this = Multiply(left, Integer(sign, magnitude));
+		return;
+	}
+	else if(left.isUndefined() | (left.isNaN() & !magnitude)) {
+		*this = Undefined();
+		return;
+	}
+	else if(left.isZero() | !magnitude) {
+		*this = Zero();
+		return;
+	}
+	else if(left.isNaN()) {
+		*this = NaN();
+		return;
+	}
+
+	auto value = num_t(magnitude);
+	Word word;
+
+	if(isWord(left) & left.m_canonical && multiplyWords(word, toWord(left), {value, 1})) {
+		assignWord(static_cast<Sign>(left.m_sign == sign), word.nom, word.den);
+		return;
+	}
+
+	// The factor the value shares with the denominator is cancelled, the nominator is coprime with both of them
+	if(reduction() == Reduction::Always) {
+		const num_t
+				remainder = rmod(rptr(left.m_den), left.m_den.size(), value),
+				common = remainder ? gcd(remainder, value) : value;
+
+		if(common != 1) {
+			m_denExp = divideChunk(spare.den, left.m_denExp, left.m_den, common);
+			swapIn(m_den, spare.den);
+			value /= common;
+		}
+		else if(this != &left) {
+			m_den = left.m_den;
+			m_denExp = left.m_denExp;
+		}
+	}
+	else if(this != &left) {
+		m_den = left.m_den;
+		m_denExp = left.m_denExp;
+	}
+
+	m_nomExp = multiplyChunk(spare.nom, left.m_nomExp, left.m_nom, value);
+	swapIn(m_nom, spare.nom);
+
+	m_sign = left.m_sign == sign;
+	m_canonical = left.m_canonical;
+	m_reducedSize = left.m_reducedSize;
+	finish();
+}
+
+void number::assignDivideInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	if(magnitude > ResultMask) {
+		*this = Divide(left, Integer(sign, magnitude));
+		return;
+	}
+	else if(left.isUndefined() | (left.isZero() & !magnitude)) {
+		*this = Undefined();
+		return;
+	}
+	else if(left.isNaN() | !magnitude) {
+		*this = NaN();
+		return;
+	}
+	else if(left.isZero()) {
+		*this = Zero();
+		return;
+	}
+
+	auto value = num_t(magnitude);
+	Word word;
+
+	if(isWord(left) & left.m_canonical && multiplyWords(word, toWord(left), {1, value})) {
+		assignWord(static_cast<Sign>(left.m_sign == sign), word.nom, word.den);
+		return;
+	}
+
+	// The factor the value shares with the nominator is cancelled, the denominator is coprime with both of them
+	if(reduction() == Reduction::Always) {
+		const num_t
+				remainder = rmod(rptr(left.m_nom), left.m_nom.size(), value),
+				common = remainder ? gcd(remainder, value) : value;
+
+		if(common != 1) {
+			m_nomExp = divideChunk(spare.nom, left.m_nomExp, left.m_nom, common);
+			swapIn(m_nom, spare.nom);
+			value /= common;
+		}
+		else if(this != &left) {
+			m_nom = left.m_nom;
+			m_nomExp = left.m_nomExp;
+		}
+	}
+	else if(this != &left) {
+		m_nom = left.m_nom;
+		m_nomExp = left.m_nomExp;
+	}
+
+	m_denExp = multiplyChunk(spare.den, left.m_denExp, left.m_den, value);
+	swapIn(m_den, spare.den);
+
+	m_sign = left.m_sign == sign;
+	m_canonical = left.m_canonical;
+	m_reducedSize = left.m_reducedSize;
+	finish();
+}
+
+void number::assignIntegerDivide(Sign sign, uint64_t magnitude, const number &right)
+{
+	// Magnitudes wider than a chunk and the special values are divided as numbers
+	if((magnitude > ResultMask) | !magnitude | !right.isNonZero() | right.isNaN()) {
+		*this = Divide(Integer(sign, magnitude), right);
+		return;
+	}
+
+	auto value = num_t(magnitude);
+	Word word;
+
+	// The reciprocal of a word swaps its chunks
+	if(isWord(right) & right.m_canonical &&
+	   multiplyWords(word, {value, 1}, {right.m_den.front(), right.m_nom.front()})) {
+		assignWord(static_cast<Sign>(right.m_sign == sign), word.nom, word.den);
+		return;
+	}
+
+	// value / right = value * den / nom, the factor the value shares with the nominator of right is cancelled
+	data_t &den = spare.den;
+	exp_t denExp = right.m_nomExp;
+
+	if(reduction() == Reduction::Always) {
+		const num_t
+				remainder = rmod(rptr(right.m_nom), right.m_nom.size(), value),
+				common = remainder ? gcd(remainder, value) : value;
+
+		if(common != 1) {
+			denExp = divideChunk(den, right.m_nomExp, right.m_nom, common);
+			value /= common;
+		}
+		else
+			den = right.m_nom;
+	}
 	else
-		return true;
-	return false;
+		den = right.m_nom;
+
+	m_nomExp = multiplyChunk(spare.nom, right.m_denExp, right.m_den, value);
+	m_denExp = denExp;
+	m_sign = right.m_sign == sign;
+	m_canonical = right.m_canonical;
+	m_reducedSize = right.m_reducedSize;
+
+	swapIn(m_nom, spare.nom);
+	swapIn(m_den, spare.den);
+	finish();
 }
 
 
+//-STATIC-ARITHMETIC-HELPER-METHODS------------------------------------------------------------------------------------
 
-//-COMPARISON-PRELIMINARY-CHECKS---------------------------------------------------------------------------------------
-//    These functions Are run before the actual computation to do bound checking, and return true if they pass
+number number::AddPositive(const number &left, const number &right)
+{
+	number result;
+	result.assignAddPositive(left, right);
+	return result;
+}
 
-enum ComparisonCheckResult {
-	Fail = false,
-	Pass = true,
-	Compare
-};
+number number::SubPositive(const number &left, const number &right)
+{
+	number result;
+	result.assignSubPositive(left, right);
+	return result;
+}
 
-static ComparisonCheckResult checkEqual(const number &left, const number &right)
+number number::Multiply(const number &left, const number &right)
 {
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftSign = left.sign(),
-			rightSign = right.sign(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+	number result;
+	result.assignMultiply(left, right);
+	return result;
+}
 
-	if(leftUndef | rightUndef | (leftSign != rightSign))
-		return Fail;
-	else if((leftNan && rightNan) || (leftZero && rightZero))
-		return Pass;
-	return Compare;
+number number::Divide(const number &left, const number &right)
+{
+	number result;
+	result.assignDivide(left, right);
+	return result;
 }
 
-static ComparisonCheckResult checkLess(const number &left, const number &right)
+number number::AddPositive(number &&left, const number &right)
 {
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftSign = left.sign(),
-			rightSign = right.sign(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+	left.assignAddPositive(left, right);
+	return std::move(left);
+}
 
-	if(leftUndef | rightUndef | ((leftZero && rightZero) || (leftNan && rightNan)))
-		return Fail;
-	else if(leftSign != rightSign)
-		return left == Sign::Negative ? Pass : Fail;
-	return Compare;
+number number::AddPositive(const number &left, number &&right)
+{
+	right.assignAddPositive(left, right);
+	return std::move(right);
 }
 
-static ComparisonCheckResult checkMore(const number &left, const number &right)
+number number::AddPositive(number &&left, number &&right)
 {
-	const bool
-			leftUndef = left.isUndefined(),
-			rightUndef = right.isUndefined(),
-			leftSign = left.sign(),
-			rightSign = right.sign(),
-			leftNan = left.isNaN(),
-			rightNan = right.isNaN(),
-			leftZero = left.isZero(),
-			rightZero = right.isZero();
+	return AddPositive(std::move(left), right);
+}
 
-	if(leftUndef | rightUndef | ((leftZero && rightZero) || (leftNan && rightNan)))
-		return Fail;
-	else if(leftSign != rightSign)
-		return left == Sign::Positive ? Pass : Fail;
-	return Compare;
+number number::SubPositive(number &&left, const number &right)
+{
+	left.assignSubPositive(left, right);
+	return std::move(left);
+}
+
+number number::SubPositive(const number &left, number &&right)
+{
+	right.assignSubPositive(left, right);
+	return std::move(right);
 }
 
+number number::SubPositive(number &&left, number &&right)
+{
+	return SubPositive(std::move(left), right);
+}
 
+number number::Multiply(number &&left, const number &right)
+{
+	left.assignMultiply(left, right);
+	return std::move(left);
+}
 
-//-CONSTRUCTORS--------------------------------------------------------------------------------------------------------
+number number::Multiply(const number &left, number &&right)
+{
+	right.assignMultiply(left, right);
+	return std::move(right);
+}
 
-number::number(int value) :
-		m_nom{num_t(std::abs(value))},
-		m_den{1},
-		m_sign{value >= 0}
+number number::Multiply(number &&left, number &&right)
 {
-	m_nomExp = truncate(m_nomExp, m_nom);
+	return Multiply(std::move(left), right);
 }
 
+number number::Divide(number &&left, const number &right)
+{
+	left.assignDivide(left, right);
+	return std::move(left);
+}
 
+number number::Divide(const number &left, number &&right)
+{
+	right.assignDivide(left, right);
+	return std::move(right);
+}
 
-//-OPERATORS-----------------------------------------------------------------------------------------------------------
+number number::Divide(number &&left, number &&right)
+{
+	return Divide(std::move(left), right);
+}
 
-number number::operator-() const
+number number::AddInteger(const number &left, Sign sign, uint64_t magnitude)
 {
-	number result = *this;
-	result.negate();
+	number result;
+	result.assignAddInteger(left, sign, magnitude);
 	return result;
 }
 
+number number::MultiplyInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	number result;
+	result.assignMultiplyInteger(left, sign, magnitude);
+	return result;
+}
 
+number number::DivideInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	number result;
+	result.assignDivideInteger(left, sign, magnitude);
+	return result;
+}
 
-//-ARITHMETIC-MEMBER-FUNCTIONS-----------------------------------------------------------------------------------------
-
-number number::power(exp_t exp) const
+number number::IntegerDivide(Sign sign, uint64_t magnitude, const number &right)
 {
-	return Power(*this, exp);
+	number result;
+	result.assignIntegerDivide(sign, magnitude, right);
+	return result;
 }
 
-number number::sqrt(digits_t) const
+number number::IntegerDivide(Sign sign, uint64_t magnitude, number &&right)
 {
-	// TODO
-	return {};
+	right.assignIntegerDivide(sign, magnitude, right);
+	return std::move(right);
 }
 
+number number::Power(const number &num, exp_t exp)
+{
+	number result;
 
+	if(checkPower(result, num, exp)) {
+		const auto isPowerOfTwo = [](const data_t &vec) { return (vec.size() == 1) & !(vec.front() & (vec.front() - 1)); };
 
-//-STATIC-ARITHMETIC-HELPER-METHODS------------------------------------------------------------------------------------
+		// Under bounded precision every square and product is rounded, so the operands never outgrow the budget
+		//     Powers of two are exact in any precision, and take no multiplications
+		if(precision() && !(isPowerOfTwo(num.m_nom) & isPowerOfTwo(num.m_den))) {
+			number base = exp > 0 ? num : Divide(One(), num);
+			base.finish();
 
-number number::AddPositive(const number &left, const number &right)
-{
-	number result;
+			const auto uexp = exp > 0 ? uexp_t(exp) : uexp_t(-exp);
+			uexp_t bit = 1;
 
-	if(checkAdd(result, left, right)) {
-		data_t leftNormal, rightNormal;
+			while(bit <= uexp >> 1)
+				bit <<= 1;
 
-		const exp_t
-				leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den),
-				rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, left.m_denExp, left.m_den);
+			result = base;
+
+			for(bit >>= 1; bit; bit >>= 1) {
+				result.assignMultiply(result, result);
+
+				if(uexp & bit)
+					result.assignMultiply(result, base);
+			}
+
+			return result;
+		}
+
+		if(exp > 0) {
+			const auto uexp = uexp_t(exp);
+
+			result.m_nomExp = ::power(result.m_nom, num.m_nomExp, num.m_nom, uexp);
+			result.m_denExp = ::power(result.m_den, num.m_denExp, num.m_den, uexp);
+		}
+		else {
+			const auto uexp = uexp_t(-exp);
+
+			result.m_nomExp = ::power(result.m_nom, num.m_denExp, num.m_den, uexp);
+			result.m_denExp = ::power(result.m_den, num.m_nomExp, num.m_nom, uexp);
+		}
+
+		// Odd powers keep the sign
+		result.m_sign = num.m_sign | !(exp & 1);
+		result.m_canonical = num.m_canonical;
 
-		result.m_denExp = multiply(result.m_den, left.m_denExp, left.m_den, right.m_denExp, right.m_den);
-		result.m_nomExp = add(result.m_nom, leftExp, std::move(leftNormal), rightExp, std::move(rightNormal));
+		// Powers of coprime values stay coprime
+		result.finish();
 	}
 
 	return result;
 }
 
-number number::SubPositive(const number &left, const number &right)
+number number::Sqrt(const number &num, digits_t bits)
 {
 	number result;
 
-	if(checkSub(result, left, right)) {
-		data_t leftNormal, rightNormal;
-
-		const exp_t
-				leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den),
-				rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, left.m_denExp, left.m_den);
+	if(checkSqrt(result, num)) {
+		// sqrt(nom / den) = sqrt(nom * den) / den, where the root of an integer needs no division
+		data_t product;
+		const exp_t productExp = multiply(product, num.m_nomExp, num.m_nom, num.m_denExp, num.m_den);
 
-		result.m_denExp = multiply(result.m_den, left.m_denExp, left.m_den, right.m_denExp, right.m_den);
+		number root(Positive, 0, data_t{}, 1, data_t{1}), den(Positive, num.m_denExp, data_t(num.m_den), 1, data_t{1});
+		root.m_nomExp = squareRoot(root.m_nom, productExp, product, bits);
 
-		const SubResult subResult = sub(result.m_nom, leftExp, std::move(leftNormal), rightExp, std::move(rightNormal));
-		result.m_nomExp = subResult.exp;
-		result.m_sign = subResult.sign;
+		result = Divide(root.normalize(), den.normalize());
 	}
 
 	return result;
 }
 
-number number::Multiply(const number &left, const number &right)
+number number::Floor(const number &num)
 {
 	number result;
 
-	if(checkMultiply(result, left, right)) {
-		result.m_nomExp = multiply(result.m_nom, left.m_nomExp, left.m_nom, right.m_nomExp, right.m_nom);
-		result.m_denExp = multiply(result.m_den, left.m_denExp, left.m_den, right.m_denExp, right.m_den);
+	if(checkRound(result, num)) {
+		data_t nom, den, quotient, remainder;
+
+		toIntegers(nom, den, num);
+		divide(quotient, remainder, nom, den);
 
-		result.m_sign = left.m_sign ^ right.m_sign;
+		// Negative values with a fractional part round away from zero
+		if((num.sign() == Negative) & !remainder.empty())
+			increment(quotient, 1);
+
+		result = Integer(num.sign(), std::move(quotient));
 	}
 
 	return result;
 }
 
-number number::Divide(const number &left, const number &right)
+number number::Trunc(const number &num)
 {
 	number result;
 
-	if(checkDivide(result, left, right)) {
-		result.m_nomExp = multiply(result.m_nom, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den);
-		result.m_denExp = multiply(result.m_den, left.m_denExp, left.m_den, right.m_nomExp, right.m_nom);
+	if(checkRound(result, num)) {
+		data_t nom, den, quotient, remainder;
 
-		result.m_sign = left.m_sign ^ right.m_sign;
+		toIntegers(nom, den, num);
+		divide(quotient, remainder, nom, den);
+
+		result = Integer(num.sign(), std::move(quotient));
 	}
 
 	return result;
 }
 
-number number::Power(const number &num, exp_t exp)
+number number::PowMod(const number &base, const number &exp, const number &modulus)
 {
 	number result;
 
-	if(checkPower(result, num, exp)) {
-		if(exp > 0) {
-			const auto uexp = uexp_t(exp);
+	if(checkPowMod(result, base, exp, modulus)) {
+		data_t baseVec, expVec, modulusVec, quotient, residue;
 
-			result.m_nomExp = ::power(result.m_nom, num.m_nomExp, num.m_nom, uexp);
-			result.m_denExp = ::power(result.m_den, num.m_denExp, num.m_den, uexp);
+		if(!toInteger(baseVec, base) | !toInteger(expVec, exp) | !toInteger(modulusVec, modulus))
+			return NaN();
+		else if(isOne(modulusVec))
+			return Zero();
+		else if(expVec.empty())
+			return One();
+
+		// The base is taken modulo the modulus, negative ones from the other side
+		if(baseVec.empty())
+			return Zero();
+
+		divide(quotient, residue, baseVec, modulusVec);
+
+		if(residue.empty())
+			return Zero();
+		else if(base.sign() == Negative) {
+			data_t difference = modulusVec;
+			subtractFrom(difference, residue);
+			residue = std::move(difference);
+		}
+
+		const size_t size = modulusVec.size();
+		const Scratch<> buffer(2 * size);
+
+		num_t
+				*const residueBase = buffer.data(),
+				*const power = buffer.data() + size;
+
+		if(modulusVec.back() & 1u) {
+			const Montgomery multiply(modulusVec);
+
+			multiply.toForm(residueBase, residue);
+			windowPower(power, residueBase, size, expVec, multiply);
+			multiply.fromForm(residue, power);
 		}
 		else {
-			const auto uexp = uexp_t(-exp);
+			const Remainders multiply(modulusVec);
 
-			result.m_nomExp = ::power(result.m_nom, num.m_denExp, num.m_den, uexp);
-			result.m_denExp = ::power(result.m_den, num.m_nomExp, num.m_nom, uexp);
+			std::fill(residueBase, residueBase + size - residue.size(), 0);
+			std::copy(residue.begin(), residue.end(), residueBase + size - residue.size());
+
+			windowPower(power, residueBase, size, expVec, multiply);
+
+			residue.assign(power, power + size);
+			trimFront(residue);
 		}
+
+		result = Integer(Positive, std::move(residue));
 	}
 
 	return result;
 }
 
-number number::Sqrt(const number &num, digits_t)
+number number::Remainder(const number &left, const number &right)
 {
 	number result;
 
-	if(checkSqrt(result, num)) {
+	if(checkRemainder(result, left, right)) {
+		data_t leftNom, leftDen, rightNom, rightDen, nom, den, quotient, remainder;
+
+		toIntegers(leftNom, leftDen, left);
+		toIntegers(rightNom, rightDen, right);
+
+		// left - trunc(left / right) * right = (leftNom * rightDen mod leftDen * rightNom) / (leftDen * rightDen)
+		multiplyIntegers(nom, leftNom, rightDen);
+		multiplyIntegers(den, leftDen, rightNom);
+		divide(quotient, remainder, nom, den);
 
+		if(remainder.empty())
+			return Zero();
+
+		multiplyIntegers(den, leftDen, rightDen);
+
+		result = number(left.sign(), exp_t(remainder.size()), std::move(remainder), exp_t(den.size()), std::move(den));
+
+		// The remainder can share factors with both denominators, so it is not reduced like the other operations, a
+		// rounded result is canonical under any policy
+		if(reduction() == Reduction::Always && !precision())
+			result.normalize();
+		else
+			result.finish();
 	}
 
 	return result;
 }
 
-bool number::Equal(const number &left, const number &right)
+number number::Normalize(const number &num)
 {
-	const auto checkResult = checkEqual(left, right);
+	number result = num;
+	return result.normalize();
+}
 
-	if(checkResult == Compare) {
-		data_t leftNormal, rightNormal;
+static thread_local number::Reduction reductionPolicy = number::DefaultReduction;
 
-		const exp_t
-				leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den),
-				rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, left.m_denExp, left.m_den);
+number::Reduction number::reduction() noexcept
+{
+	return reductionPolicy;
+}
 
-		return leftExp == rightExp && leftNormal == rightNormal;
-	}
+void number::setReduction(Reduction policy) noexcept
+{
+	reductionPolicy = policy;
+}
+
+static thread_local size_t precisionChunks = number::DefaultPrecision;
+
+size_t number::precision() noexcept
+{
+	return precisionChunks;
+}
+
+void number::setPrecision(size_t chunks) noexcept
+{
+	precisionChunks = chunks;
+}
+
+size_t number::threads() noexcept
+{
+	return threadLimit;
+}
+
+void number::setThreads(size_t count) noexcept
+{
+	threadLimit = count;
+}
+
+bool number::Equal(const number &left, const number &right)
+{
+	const auto checkResult = checkEqual(left, right);
+
+	// Canonical forms of equal values are identical, so they are compared without any multiplication
+	if(checkResult == Compare && left.m_canonical & right.m_canonical)
+		return (left.m_nomExp == right.m_nomExp) & (left.m_denExp == right.m_denExp) &&
+			   left.m_nom == right.m_nom && left.m_den == right.m_den;
+	else if(checkResult == Compare)
+		return !compareCross(left, right);
 	else
 		return bool(checkResult);
 }
@@ -749,24 +5108,9 @@ bool number::Less(const number &left, const number &right)
 	const auto checkResult = checkLess(left, right);
 
 	if(checkResult == Compare) {
-		data_t leftNormal, rightNormal;
-
-		const exp_t
-				leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den),
-				rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, left.m_denExp, left.m_den);
+		const int order = compareCross(left, right);
 
-		if(left.sign() == Sign::Positive) {
-			if(leftExp == rightExp)
-				return leftNormal < rightNormal;
-			else
-				return leftExp < rightExp;
-		}
-		else {
-			if(leftExp == rightExp)
-				return leftNormal > rightNormal;
-			else
-				return leftExp > rightExp;
-		}
+		return left.sign() == Sign::Positive ? order < 0 : order > 0;
 	}
 	else
 		return bool(checkResult);
@@ -782,24 +5126,9 @@ bool number::More(const number &left, const number &right)
 	const auto checkResult = checkMore(left, right);
 
 	if(checkResult == Compare) {
-		data_t leftNormal, rightNormal;
-
-		const exp_t
-				leftExp = multiply(leftNormal, left.m_nomExp, left.m_nom, right.m_denExp, right.m_den),
-				rightExp = multiply(rightNormal, right.m_nomExp, right.m_nom, left.m_denExp, left.m_den);
+		const int order = compareCross(left, right);
 
-		if(left.sign() == Sign::Positive) {
-			if(leftExp == rightExp)
-				return leftNormal > rightNormal;
-			else
-				return leftExp > rightExp;
-		}
-		else {
-			if(leftExp == rightExp)
-				return leftNormal < rightNormal;
-			else
-				return leftExp < rightExp;
-		}
+		return left.sign() == Sign::Positive ? order > 0 : order < 0;
 	}
 	else
 		return bool(checkResult);
@@ -810,6 +5139,137 @@ bool number::MoreEqual(const number &left, const number &right)
 	return !Less(left, right);
 }
 
+int number::OrderInteger(const number &left, Sign sign, uint64_t magnitude)
+{
+	// Magnitudes wider than a chunk are compared as numbers
+	if(magnitude > ResultMask)
+		return compareOrder(left, Integer(sign, magnitude));
+	else if(left.isUndefined() | left.isNaN())
+		return Unordered;
+	else if(left.isZero() & !magnitude)
+		return 0;
+	else if(left.isZero())
+		return sign == Positive ? -1 : 1;
+	else if(!magnitude | (left.m_sign != sign))
+		return left.m_sign == Positive ? 1 : -1;
+
+	const int order = compareChunk(left, num_t(magnitude));
+
+	return left.m_sign == Positive ? order : -order;
+}
+
+
+
+//-BATCH-ARITHMETIC-METHODS--------------------------------------------------------------------------------------------
+
+// Rows of a batch are cut into this many tasks, that the lanes of a fork share
+static constexpr size_t BatchTasks = 64;
+
+// Combined size in chunks of the operands of a batch, or of the values of a tree, from which they run in parallel
+static constexpr size_t ParallelBatchSize = size_t(1) << 14u;
+
+template<typename Row>
+static void runBatch(const number *left, const number *right, size_t count, const Row &row)
+{
+	size_t size = 0;
+
+	for(size_t index = 0; index < count && size < ParallelBatchSize; ++index)
+		size += left[index].nom().size() + left[index].den().size() + right[index].nom().size() + right[index].den().size();
+
+	forkJoin<BatchTasks>(size >= ParallelBatchSize, [&](size_t task) {
+		const size_t
+				first = task * count / BatchTasks,
+				last = (task + 1) * count / BatchTasks;
+
+		for(size_t index = first; index < last; ++index)
+			row(index);
+	});
+}
+
+// Combines count values in a balanced tree, whose halves run in parallel when enabled
+//     count > 0
+
+template<typename Combine>
+static number combineTree(const number *values, size_t count, bool parallel, const Combine &combine)
+{
+	if(count == 1)
+		return values[0];
+	else if(count == 2)
+		return combine(values[0], values[1]);
+
+	const size_t half = count / 2;
+	number lower, upper;
+
+	forkJoin<2>(parallel, [&](size_t task) {
+		if(task == 0)
+			lower = combineTree(values, half, parallel, combine);
+		else
+			upper = combineTree(values + half, count - half, parallel, combine);
+	});
+
+	return combine(std::move(lower), std::move(upper));
+}
+
+static bool isLargeTree(const number *values, size_t count)
+{
+	size_t size = 0;
+
+	for(size_t index = 0; index < count && size < ParallelBatchSize; ++index)
+		size += values[index].nom().size() + values[index].den().size();
+
+	return size >= ParallelBatchSize;
+}
+
+void number::Add(number *result, const number *left, const number *right, size_t count)
+{
+	runBatch(left, right, count, [=](size_t index) {
+		result[index].assignAdd(left[index], right[index], right[index].sign());
+	});
+}
+
+void number::Sub(number *result, const number *left, const number *right, size_t count)
+{
+	runBatch(left, right, count, [=](size_t index) {
+		result[index].assignAdd(left[index], right[index], Sign(!right[index].sign()));
+	});
+}
+
+void number::Multiply(number *result, const number *left, const number *right, size_t count)
+{
+	runBatch(left, right, count, [=](size_t index) { result[index].assignMultiply(left[index], right[index]); });
+}
+
+void number::Divide(number *result, const number *left, const number *right, size_t count)
+{
+	runBatch(left, right, count, [=](size_t index) { result[index].assignDivide(left[index], right[index]); });
+}
+
+void number::Order(int *result, const number *left, const number *right, size_t count)
+{
+	runBatch(left, right, count, [=](size_t index) { result[index] = compareOrder(left[index], right[index]); });
+}
+
+number number::Sum(const number *values, size_t count)
+{
+	// Every inner sum brings its operands to the common denominator that cancels the factors their denominators share
+	if(!count)
+		return Zero();
+
+	return combineTree(values, count, isLargeTree(values, count), [](auto &&left, auto &&right) {
+		return std::forward<decltype(left)>(left) + std::forward<decltype(right)>(right);
+	});
+}
+
+number number::Product(const number *values, size_t count)
+{
+	if(!count)
+		return One();
+
+	return combineTree(values, count, isLargeTree(values, count), [](auto &&left, auto &&right) {
+		return std::forward<decltype(left)>(left) * std::forward<decltype(right)>(right);
+	});
+}
+
 
 
 //-GLOBAL-OPERATOR-OVERLOADS-------------------------------------------------------------------------------------------
@@ -863,7 +5323,7 @@ number operator-(const number &left, const number &right)
 
 					// -left - -right <=> right - left
 				case Sign::Negative:
-					return number::SubPositive(right, left).negate();
+					return number::SubPositive(right, left);
 			}
 	}
 }
@@ -878,6 +5338,109 @@ number operator/(const number &left, const number &right)
 	return number::Divide(left, right);
 }
 
+number operator%(const number &left, const number &right)
+{
+	return number::Remainder(left, right);
+}
+
+number operator+(number &&left, const number &right)
+{
+	return std::move(left += right);
+}
+
+number operator+(const number &left, number &&right)
+{
+	// Same cases as in operator+, where the right operand holds the result
+	switch(left.sign()) {
+		case Sign::Positive:
+			switch(right.sign()) {
+				case Sign::Positive:
+					return number::AddPositive(left, std::move(right));
+
+				case Sign::Negative:
+					return number::SubPositive(left, std::move(right));
+			}
+
+		case Sign::Negative:
+			switch(right.sign()) {
+				case Sign::Positive:
+					return number::SubPositive(std::move(right), left);
+
+				case Sign::Negative:
+					return -number::AddPositive(left, std::move(right));
+			}
+	}
+}
+
+number operator+(number &&left, number &&right)
+{
+	return std::move(left += right);
+}
+
+number operator-(number &&left, const number &right)
+{
+	return std::move(left -= right);
+}
+
+number operator-(const number &left, number &&right)
+{
+	// Same cases as in operator-, where the right operand holds the result
+	switch(left.sign()) {
+		case Sign::Positive:
+			switch(right.sign()) {
+				case Sign::Positive:
+					return number::SubPositive(left, std::move(right));
+
+				case Sign::Negative:
+					return number::AddPositive(left, std::move(right));
+			}
+
+		case Sign::Negative:
+			switch(right.sign()) {
+				case Sign::Positive:
+					return -number::AddPositive(std::move(right), left);
+
+				case Sign::Negative:
+					return number::SubPositive(std::move(right), left);
+			}
+	}
+}
+
+number operator-(number &&left, number &&right)
+{
+	return std::move(left -= right);
+}
+
+number operator*(number &&left, const number &right)
+{
+	return number::Multiply(std::move(left), right);
+}
+
+number operator*(const number &left, number &&right)
+{
+	return number::Multiply(left, std::move(right));
+}
+
+number operator*(number &&left, number &&right)
+{
+	return number::Multiply(std::move(left), std::move(right));
+}
+
+number operator/(number &&left, const number &right)
+{
+	return number::Divide(std::move(left), right);
+}
+
+number operator/(const number &left, number &&right)
+{
+	return number::Divide(left, std::move(right));
+}
+
+number operator/(number &&left, number &&right)
+{
+	return number::Divide(std::move(left), std::move(right));
+}
+
 bool operator==(const number &left, const number &right)
 {
 	return number::Equal(left, right);
@@ -922,7 +5485,7 @@ std::ostream &operator<<(std::ostream &out, const number &value)
 			<< "        0x";
 
 		for(const auto &val : vec)
-			out << std::setfill('0') << std::setw(8) << val;
+			out << std::setfill('0') << std::setw(number::ChunkBits / 4) << val;
 
 		out << std::dec << "\n";
 	};
@@ -3,8 +3,29 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "small_vector.hpp"
+
+// Width of a numeric chunk in bits, 64-bit chunks need a native 128-bit integer for intermediate results
+#ifndef BRNO_NUMBER_CHUNK_BITS
+#	if defined(__SIZEOF_INT128__)
+#		define BRNO_NUMBER_CHUNK_BITS 64
+#	else
+#		define BRNO_NUMBER_CHUNK_BITS 32
+#	endif
+#endif
+
+#if BRNO_NUMBER_CHUNK_BITS != 32 && BRNO_NUMBER_CHUNK_BITS != 64
+#	error "BRNO_NUMBER_CHUNK_BITS must be 32 or 64"
+#elif BRNO_NUMBER_CHUNK_BITS == 64 && !defined(__SIZEOF_INT128__)
+#	error "64-bit chunks require a compiler with unsigned __int128"
+#endif
+
 class number {
 
 	//-TYPE-DEFINITIONS------------------------------------------------------------------------------------------------
@@ -19,6 +40,26 @@ public:
 		Negative = false
 	};
 
+	// Policy of reducing fractions after arithmetic operations
+	enum class Reduction {
+		// Results are kept as computed, normalize() reduces them on demand
+		Never,
+		// Results are normalized once their nominator and denominator exceed LazyReductionSize chunks, and twice their
+		// combined size at the last reduction
+		Lazy,
+		// Common factors are cancelled during every operation, results are always in canonical form
+		Always
+	};
+
+#if BRNO_NUMBER_CHUNK_BITS == 64
+	// A type for a numeric chunk
+	using num_t = uint64_t;
+	using snum_t = int64_t;
+
+	// A type for an arithmetic operation on a chunk (for overflow checking)
+	__extension__ using result_t = unsigned __int128;
+	__extension__ using sresult_t = __int128;
+#else
 	// A type for a numeric chunk
 	using num_t = uint32_t;
 	using snum_t = int32_t;
@@ -26,14 +67,20 @@ public:
 	// A type for an arithmetic operation on a chunk (for overflow checking)
 	using result_t = uint64_t;
 	using sresult_t = int64_t;
+#endif
 
 	// Types for various numeric values
 	using digits_t = uint32_t;
 	using exp_t = int64_t;
 	using uexp_t = uint64_t;
 
-	// A type for a vector of numeric chunks
-	using data_t = std::vector<num_t>;
+	// A type for a vector of numeric chunks, the few chunks of most values are stored without an allocation
+	using data_t = small_vector<num_t, 4>;
+
+	// Enables a template for the integral types other than bool that fit in 64 bits, taken as machine integers
+	template<typename T>
+	using if_integer_t = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+										  sizeof(T) <= sizeof(uint64_t), int>;
 
 
 
@@ -41,11 +88,61 @@ public:
 
 	static constexpr Sign DefaultSign = Positive;
 	static constexpr exp_t DefaultExponent = 0;
+	static constexpr Reduction DefaultReduction = Reduction::Always;
+
+	// Smallest combined size of the nominator and the denominator in chunks that triggers reduction in the lazy policy
+	static constexpr size_t LazyReductionSize = 32;
+
+	// Precision in chunks that arithmetic results are rounded to, zero keeps them exact
+	//     Rounded values are integers of at most that many chunks scaled by a power of the chunk, results are rounded
+	//     to the nearest one, and ties to the one with an even last chunk
+	static constexpr size_t DefaultPrecision = 0;
+
+	// Threads that a single operation may use, zero uses all the hardware threads
+	static constexpr size_t DefaultThreads = 0;
+
+	// Order of operands of which one is NaN or Undefined, as given by the batch comparison
+	static constexpr int Unordered = 2;
+
+	// Number of bits in a numeric chunk
+	static constexpr digits_t ChunkBits = std::numeric_limits<num_t>::digits;
+
+#if BRNO_NUMBER_CHUNK_BITS == 64
+	// Operand sizes in chunks from which the multiplication switches to a faster algorithm
+	static constexpr size_t KaratsubaThreshold = 32;
+	static constexpr size_t Toom3Threshold = 96;
+	static constexpr size_t NttThreshold = 1024;
+
+	// Squares have cheaper base cases, so they switch to a faster algorithm later
+	static constexpr size_t KaratsubaSquareThreshold = 48;
+	static constexpr size_t Toom3SquareThreshold = 128;
+
+	// Divisor size in chunks from which the division splits into recursive halves
+	static constexpr size_t BurnikelZieglerThreshold = 64;
+
+	// Smaller operand size in chunks from which the sub-products of a multiplication run in parallel
+	static constexpr size_t ParallelThreshold = 512;
+#else
+	// Operand sizes in chunks from which the multiplication switches to a faster algorithm
+	static constexpr size_t KaratsubaThreshold = 40;
+	static constexpr size_t Toom3Threshold = 128;
+	static constexpr size_t NttThreshold = 2048;
+
+	// Squares have cheaper base cases, so they switch to a faster algorithm later
+	static constexpr size_t KaratsubaSquareThreshold = 48;
+	static constexpr size_t Toom3SquareThreshold = 160;
+
+	// Divisor size in chunks from which the division splits into recursive halves
+	static constexpr size_t BurnikelZieglerThreshold = 80;
+
+	// Smaller operand size in chunks from which the sub-products of a multiplication run in parallel
+	static constexpr size_t ParallelThreshold = 1024;
+#endif
 
 	// Bit offset of the overflow part of the result
-	static constexpr result_t OverflowOffset = std::numeric_limits<result_t>::digits / 2;
+	static constexpr result_t OverflowOffset = ChunkBits;
 	// Bit mask of the result part of the result
-	static constexpr result_t ResultMask = std::numeric_limits<result_t>::max() >> OverflowOffset;
+	static constexpr result_t ResultMask = std::numeric_limits<num_t>::max();
 	// Bit mask of the overflow part of the result
 	static constexpr result_t OverflowMask = ~ResultMask;
 
@@ -53,6 +150,8 @@ public:
 
 	//-MEMBER-DECLARATIONS---------------------------------------------------------------------------------------------
 	// Value = (m_sign ? 1 : -1) * (m_nom / m_den) * 2^(sizeof(chunk) * m_exp)
+	//     Chunks of a vector are stored from the most significant, the first one is placed just below its exponent
+	//     In canonical form the nominator and the denominator are coprime, and the denominator exponent is zero
 private:
 
 	// Nominator and Denominator
@@ -66,6 +165,12 @@ private:
 	// Sign
 	sign_t m_sign = DefaultSign;
 
+	// Set when the value is known to be in canonical form, where equal values have equal representations
+	bool m_canonical = false;
+
+	// Combined size of the nominator and the denominator in chunks when the value or its operands were last reduced
+	size_t m_reducedSize = 0;
+
 
 
 	//-DEFAULT-CONSTRUCTORS-&-ASSIGNMENTS------------------------------------------------------------------------------
@@ -83,13 +188,17 @@ public:
 	// Implicitly convertible constructor from an int value
 	number(int value);
 
+	// Implicitly convertible constructor from the other integral values
+	template<typename T, if_integer_t<T> = 0>
+	inline number(T value) : number(Integer(IntegerSign(value), IntegerMagnitude(value))) {}
+
+	// Explicit constructor from digits in a radix from 2 to 36, with an optional sign and a fractional part after a
+	// point, text that is not a number gives NaN
+	explicit number(std::string_view text, unsigned radix = 10);
+
 	// Explicit constructor for testing and debugging purposes
-	inline explicit number(Sign sign, exp_t nomExp, data_t &&nom, exp_t denExp, data_t &&den) noexcept :
-			m_nom{std::move(nom)},
-			m_den{std::move(den)},
-			m_nomExp{nomExp},
-			m_denExp{denExp},
-			m_sign{sign} {}
+	//     Zero chunks around the vectors are dropped, as the arithmetic expects truncated vectors
+	explicit number(Sign sign, exp_t nomExp, data_t &&nom, exp_t denExp, data_t &&den) noexcept;
 
 
 	// Special value constructors
@@ -111,6 +220,25 @@ public:
 	}
 
 
+	// Sign and magnitude of a machine integer
+	template<typename T>
+	static constexpr Sign IntegerSign(T value) noexcept
+	{
+		if constexpr(std::is_signed<T>::value)
+			return static_cast<Sign>(value >= 0);
+		else
+			return Positive;
+	}
+	template<typename T>
+	static constexpr uint64_t IntegerMagnitude(T value) noexcept
+	{
+		if constexpr(std::is_signed<T>::value)
+			return value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+		else
+			return uint64_t(value);
+	}
+
+
 
 	//-MEMBER-ACCESSORS------------------------------------------------------------------------------------------------
 
@@ -120,6 +248,7 @@ public:
 	inline exp_t nomExp() const noexcept { return m_nomExp; }
 	inline exp_t denExp() const noexcept { return m_denExp; }
 	inline Sign sign() const noexcept { return static_cast<Sign>(m_sign); }
+	inline bool isCanonical() const noexcept { return m_canonical; }
 
 	inline bool isZero() const noexcept { return m_nom.empty() & !m_den.empty(); }
 	inline bool isNonZero() const noexcept { return !m_nom.empty(); }
@@ -131,13 +260,53 @@ public:
 
 	//-OPERATORS-------------------------------------------------------------------------------------------------------
 
-	number operator-() const;
+	number operator-() const &;
+	number operator-() &&;
+
+	// Compound assignments compute into the vectors of this number, and reuse their buffers for the next result
+	number &operator+=(const number &other);
+	number &operator-=(const number &other);
+	number &operator*=(const number &other);
+	number &operator/=(const number &other);
+
+	// Compound assignments of machine integers
+	template<typename T, if_integer_t<T> = 0>
+	inline number &operator+=(T other)
+	{
+		assignAddInteger(*this, IntegerSign(other), IntegerMagnitude(other));
+		return *this;
+	}
+	template<typename T, if_integer_t<T> = 0>
+	inline number &operator-=(T other)
+	{
+		assignAddInteger(*this, static_cast<Sign>(!IntegerSign(other)), IntegerMagnitude(other));
+		return *this;
+	}
+	template<typename T, if_integer_t<T> = 0>
+	inline number &operator*=(T other)
+	{
+		assignMultiplyInteger(*this, IntegerSign(other), IntegerMagnitude(other));
+		return *this;
+	}
+	template<typename T, if_integer_t<T> = 0>
+	inline number &operator/=(T other)
+	{
+		assignDivideInteger(*this, IntegerSign(other), IntegerMagnitude(other));
+		return *this;
+	}
 
 	// Returns true if number is non-zero
 	explicit inline operator bool() const noexcept { return isNonZero(); }
 
 
 
+	//-CONVERSION-MEMBER-FUNCTIONS-------------------------------------------------------------------------------------
+
+	// Digits of the value in a radix from 2 to 36, with digits places of the radix after the point rounded toward zero
+	std::string toString(digits_t digits = 0, unsigned radix = 10) const;
+
+
+
 	//-ARITHMETIC-MEMBER-FUNCTIONS-------------------------------------------------------------------------------------
 
 	// Turn a number negative
@@ -148,7 +317,18 @@ public:
 	}
 
 	number power(exp_t exp) const;
-	number sqrt(digits_t digits) const;
+	// Power of an integer modulo a positive integer, NaN for a negative exponent or fractional operands
+	number powmod(const number &exp, const number &modulus) const;
+	// Square root correct to at least bits significant binary digits whatever the radix it is printed in, so that n
+	// decimal digits need about 3.33 * n bits, NaN for negative values
+	number sqrt(digits_t bits) const;
+
+	// Nearest integer below the value, and the integer part of the value
+	number floor() const;
+	number trunc() const;
+
+	// Reduce the fraction to its canonical form
+	number &normalize();
 
 
 
@@ -163,6 +343,55 @@ protected:
 			m_denExp{denExp},
 			m_sign{sign} {}
 
+	// Number of an integer vector with its trailing zero chunks, which is in canonical form
+	static number Integer(Sign sign, data_t &&vec);
+	// Number of a machine integer, which is in canonical form
+	static number Integer(Sign sign, uint64_t magnitude);
+
+	// Rewrites left and right over their common denominator into den, and their nominators into leftNormal
+	// and rightNormal, returns the gcd of the denominators that the sum of the nominators can still share with it
+	static data_t CommonDenominator(exp_t &denExp, data_t &den,
+									exp_t &leftExp, data_t &leftNormal,
+									exp_t &rightExp, data_t &rightNormal,
+									const number &left, const number &right);
+
+	// Cancels the factors of common shared by the nominator and the denominator, and applies the reduction policy
+	void reduce(const data_t &common);
+
+	// Cancels binary factors shared with the exponent, and moves the scale of the value into the nominator exponent
+	void canonicalize();
+
+	// Applies the reduction policy to the result of an operation over pre-reduced operands
+	//     m_canonical has to be set beforehand to whether all the operands were canonical, and m_reducedSize to the
+	//     largest one of the operands
+	void finish();
+
+	// Rounds a non-zero value to the precision of the calling thread, which leaves it in canonical form
+	void roundToPrecision();
+
+	// Assigns the operand of a sum or difference that the other one is too small to change after rounding, and returns
+	// whether there is one, the other operand is subtracted when rightSign is negative
+	bool assignDominant(const number &left, const number &right, Sign rightSign);
+
+	// Assigns the fraction nom / den of coprime chunks, which is in canonical form
+	void assignWord(Sign sign, num_t nom, num_t den);
+
+	// Assign the result of an operation to this number, which can be one of the operands
+	void assignAddPositive(const number &left, const number &right);
+	void assignSubPositive(const number &left, const number &right);
+	void assignMultiply(const number &left, const number &right);
+	void assignDivide(const number &left, const number &right);
+
+	// Assign the sum of left and right, or their difference when rightSign is negative
+	void assignAdd(const number &left, const number &right, Sign rightSign);
+
+	// Assign the result of an operation with a machine integer, which changes only one of the vectors of left
+	void assignAddInteger(const number &left, Sign sign, uint64_t magnitude);
+	void assignMultiplyInteger(const number &left, Sign sign, uint64_t magnitude);
+	void assignDivideInteger(const number &left, Sign sign, uint64_t magnitude);
+	// Assign the machine integer divided by right, which changes both of the vectors of right
+	void assignIntegerDivide(Sign sign, uint64_t magnitude, const number &right);
+
 
 
 	//-STATIC-ARITHMETIC-HELPER-METHODS--------------------------------------------------------------------------------
@@ -171,8 +400,49 @@ public:
 	static number SubPositive(const number &left, const number &right);
 	static number Multiply(const number &left, const number &right);
 	static number Divide(const number &left, const number &right);
+
+	// Overloads for temporary operands compute the result into the vectors of one of them
+	static number AddPositive(number &&left, const number &right);
+	static number AddPositive(const number &left, number &&right);
+	static number AddPositive(number &&left, number &&right);
+	static number SubPositive(number &&left, const number &right);
+	static number SubPositive(const number &left, number &&right);
+	static number SubPositive(number &&left, number &&right);
+	static number Multiply(number &&left, const number &right);
+	static number Multiply(const number &left, number &&right);
+	static number Multiply(number &&left, number &&right);
+	static number Divide(number &&left, const number &right);
+	static number Divide(const number &left, number &&right);
+	static number Divide(number &&left, number &&right);
+
+	// Operations with a machine integer of the sign and magnitude
+	static number AddInteger(const number &left, Sign sign, uint64_t magnitude);
+	static number MultiplyInteger(const number &left, Sign sign, uint64_t magnitude);
+	static number DivideInteger(const number &left, Sign sign, uint64_t magnitude);
+	static number IntegerDivide(Sign sign, uint64_t magnitude, const number &right);
+	static number IntegerDivide(Sign sign, uint64_t magnitude, number &&right);
+
 	static number Power(const number &num, exp_t exp);
-	static number Sqrt(const number &num, digits_t digits);
+	// base^exp mod modulus, which is in [0, modulus)
+	static number PowMod(const number &base, const number &exp, const number &modulus);
+	static number Sqrt(const number &num, digits_t bits);
+	static number Floor(const number &num);
+	static number Trunc(const number &num);
+	// left - trunc(left / right) * right, which has the sign of left
+	static number Remainder(const number &left, const number &right);
+	static number Normalize(const number &num);
+
+	// Reduction policy of the calling thread
+	static Reduction reduction() noexcept;
+	static void setReduction(Reduction policy) noexcept;
+
+	// Precision of the calling thread in chunks
+	static size_t precision() noexcept;
+	static void setPrecision(size_t chunks) noexcept;
+
+	// Threads that a single operation of the calling thread may use, zero for all the hardware threads
+	static size_t threads() noexcept;
+	static void setThreads(size_t count) noexcept;
 
 	static bool Equal(const number &left, const number &right);
 	static bool NotEqual(const number &left, const number &right);
@@ -180,6 +450,35 @@ public:
 	static bool LessEqual(const number &left, const number &right);
 	static bool More(const number &left, const number &right);
 	static bool MoreEqual(const number &left, const number &right);
+
+	// Order of left and a machine integer of the sign and magnitude as -1, 0 or 1, or Unordered
+	static int OrderInteger(const number &left, Sign sign, uint64_t magnitude);
+
+	template<typename T, if_integer_t<T> = 0>
+	static inline int OrderInteger(const number &left, T right)
+	{
+		return OrderInteger(left, IntegerSign(right), IntegerMagnitude(right));
+	}
+
+
+
+	//-BATCH-ARITHMETIC-METHODS----------------------------------------------------------------------------------------
+	// Elementwise operations over arrays of count numbers, result[i] = left[i] op right[i]
+	//     Results are computed into the vectors of the numbers in result, which may be the left or the right array,
+	//     and large batches are split between the threads that the thread limit of the calling thread allows
+
+	static void Add(number *result, const number *left, const number *right, size_t count);
+	static void Sub(number *result, const number *left, const number *right, size_t count);
+	static void Multiply(number *result, const number *left, const number *right, size_t count);
+	static void Divide(number *result, const number *left, const number *right, size_t count);
+
+	// Order of left[i] and right[i] as -1, 0 or 1, or Unordered
+	static void Order(int *result, const number *left, const number *right, size_t count);
+
+	// Sum and product of count values, combined in a balanced tree so that the large operations get operands of
+	// similar sizes, the sum of no values is Zero and their product One
+	static number Sum(const number *values, size_t count);
+	static number Product(const number *values, size_t count);
 };
 
 
@@ -190,6 +489,21 @@ number operator+(const number &left, const number &right);
 number operator-(const number &left, const number &right);
 number operator*(const number &left, const number &right);
 number operator/(const number &left, const number &right);
+number operator%(const number &left, const number &right);
+
+// Overloads for temporary operands reuse their vectors for the result
+number operator+(number &&left, const number &right);
+number operator+(const number &left, number &&right);
+number operator+(number &&left, number &&right);
+number operator-(number &&left, const number &right);
+number operator-(const number &left, number &&right);
+number operator-(number &&left, number &&right);
+number operator*(number &&left, const number &right);
+number operator*(const number &left, number &&right);
+number operator*(number &&left, number &&right);
+number operator/(number &&left, const number &right);
+number operator/(const number &left, number &&right);
+number operator/(number &&left, number &&right);
 
 bool operator==(const number &left, const number &right);
 bool operator!=(const number &left, const number &right);
@@ -199,3 +513,99 @@ bool operator>(const number &left, const number &right);
 bool operator>=(const number &left, const number &right);
 
 std::ostream &operator<<(std::ostream &out, const number &value);
+
+
+// Operations with machine integers of any integral type
+//     The integer is combined directly with the vectors of the number as a single chunk
+
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator+(const number &left, T right)
+{
+	return number::AddInteger(left, number::IntegerSign(right), number::IntegerMagnitude(right));
+}
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator+(T left, const number &right)
+{
+	return number::AddInteger(right, number::IntegerSign(left), number::IntegerMagnitude(left));
+}
+
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator-(const number &left, T right)
+{
+	const auto sign = static_cast<number::Sign>(!number::IntegerSign(right));
+	return number::AddInteger(left, sign, number::IntegerMagnitude(right));
+}
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator-(T left, const number &right)
+{
+	return number::AddInteger(-right, number::IntegerSign(left), number::IntegerMagnitude(left));
+}
+
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator*(const number &left, T right)
+{
+	return number::MultiplyInteger(left, number::IntegerSign(right), number::IntegerMagnitude(right));
+}
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator*(T left, const number &right)
+{
+	return number::MultiplyInteger(right, number::IntegerSign(left), number::IntegerMagnitude(left));
+}
+
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator/(const number &left, T right)
+{
+	return number::DivideInteger(left, number::IntegerSign(right), number::IntegerMagnitude(right));
+}
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator/(T left, const number &right)
+{
+	return number::IntegerDivide(number::IntegerSign(left), number::IntegerMagnitude(left), right);
+}
+
+// Temporary numbers take the integer in place through the assignment operators
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator+(number &&left, T right) { return std::move(left += right); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator+(T left, number &&right) { return std::move(right += left); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator-(number &&left, T right) { return std::move(left -= right); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator-(T left, number &&right) { return std::move(right.negate() += left); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator*(number &&left, T right) { return std::move(left *= right); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator*(T left, number &&right) { return std::move(right *= left); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator/(number &&left, T right) { return std::move(left /= right); }
+template<typename T, number::if_integer_t<T> = 0>
+inline number operator/(T left, number &&right)
+{
+	return number::IntegerDivide(number::IntegerSign(left), number::IntegerMagnitude(left), std::move(right));
+}
+
+// Comparisons order the number against the integer as a single chunk
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator==(const number &left, T right) { return number::OrderInteger(left, right) == 0; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator==(T left, const number &right) { return number::OrderInteger(right, left) == 0; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator!=(const number &left, T right) { return number::OrderInteger(left, right) != 0; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator!=(T left, const number &right) { return number::OrderInteger(right, left) != 0; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator<(const number &left, T right) { return number::OrderInteger(left, right) == -1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator<(T left, const number &right) { return number::OrderInteger(right, left) == 1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator<=(const number &left, T right) { return number::OrderInteger(left, right) != 1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator<=(T left, const number &right) { return number::OrderInteger(right, left) != -1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator>(const number &left, T right) { return number::OrderInteger(left, right) == 1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator>(T left, const number &right) { return number::OrderInteger(right, left) == -1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator>=(const number &left, T right) { return number::OrderInteger(left, right) != -1; }
+template<typename T, number::if_integer_t<T> = 0>
+inline bool operator>=(T left, const number &right) { return number::OrderInteger(right, left) != 1; }
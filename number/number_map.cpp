@@ -0,0 +1,286 @@
+#include "number_map.hpp"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+//-ENCODING-DEFINITIONS------------------------------------------------------------------------------------------------
+
+using num_t = number::num_t;
+using exp_t = number::exp_t;
+using data_t = number::data_t;
+using Sign = number::Sign;
+
+static constexpr char Magic[8] = {'b', 'r', 'n', 'o', 'n', 'u', 'm', '\0'};
+static constexpr uint32_t ByteOrder = 0x01020304;
+
+// Records and the chunks in them are aligned to this many bytes
+static constexpr size_t Alignment = 8;
+
+enum RecordFlags : uint8_t {
+	PositiveFlag = 1,
+	CanonicalFlag = 2
+};
+
+struct FileHeader {
+	char magic[8];
+	uint16_t version;
+	uint8_t chunkBytes;
+	uint8_t reserved;
+	uint32_t byteOrder;
+	uint64_t count;
+};
+
+struct RecordHeader {
+	uint8_t flags;
+	uint8_t reserved[3];
+	uint32_t nomSize;
+	uint32_t denSize;
+	uint32_t padding;
+	int64_t nomExp;
+	int64_t denExp;
+};
+
+static_assert(sizeof(FileHeader) == 24 && sizeof(RecordHeader) == 32, "encoding headers must not be padded");
+
+
+static inline size_t alignUp(size_t size) noexcept
+{
+	return (size + Alignment - 1) / Alignment * Alignment;
+}
+
+static inline size_t recordSize(size_t nomSize, size_t denSize) noexcept
+{
+	return sizeof(RecordHeader) + alignUp((nomSize + denSize) * sizeof(num_t));
+}
+
+
+
+//-NUMBER-VIEW---------------------------------------------------------------------------------------------------------
+
+number number_view::toNumber() const
+{
+	data_t nom, den;
+
+	nom.assign(m_nom.begin(), m_nom.end());
+	den.assign(m_den.begin(), m_den.end());
+
+	number result(m_sign, m_nomExp, std::move(nom), m_denExp, std::move(den));
+
+	// The constructor truncates the vectors, and the flag of the encoding is not trusted, a value marked canonical is
+	// normalized again, which leaves a really canonical one unchanged for the cost of its gcd
+	if(m_canonical)
+		result.normalize();
+
+	return result;
+}
+
+
+
+//-CONSTRUCTORS-&-ASSIGNMENTS------------------------------------------------------------------------------------------
+
+number_map::number_map(const char *path)
+{
+#if defined(_WIN32)
+	const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+									nullptr);
+
+	if(file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER fileSize;
+	const HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= LONGLONG(sizeof(FileHeader)) ?
+						   CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+
+	CloseHandle(file);
+
+	if(!mapping)
+		return;
+
+	const void *const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if(!view)
+		return;
+
+	m_data = static_cast<const unsigned char *>(view);
+	m_size = size_t(fileSize.QuadPart);
+#else
+	const int file = open(path, O_RDONLY);
+
+	if(file < 0)
+		return;
+
+	struct stat status;
+	void *view = nullptr;
+
+	if(!fstat(file, &status) && status.st_size >= off_t(sizeof(FileHeader))) {
+		view = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+
+		if(view == MAP_FAILED)
+			view = nullptr;
+	}
+
+	::close(file);
+
+	if(!view)
+		return;
+
+	m_data = static_cast<const unsigned char *>(view);
+	m_size = size_t(status.st_size);
+#endif
+
+	FileHeader header;
+	std::memcpy(&header, m_data, sizeof(header));
+
+	// The index has to fit in the file, records are checked when they are viewed
+	const bool valid =
+			!std::memcmp(header.magic, Magic, sizeof(Magic)) &&
+			header.version == Version &&
+			header.chunkBytes == sizeof(num_t) &&
+			header.byteOrder == ByteOrder &&
+			header.count <= (m_size - sizeof(FileHeader)) / sizeof(uint64_t);
+
+	if(valid)
+		m_count = size_t(header.count);
+	else
+		close();
+}
+
+number_map::number_map(number_map &&other) noexcept :
+		m_data{std::exchange(other.m_data, nullptr)},
+		m_size{std::exchange(other.m_size, 0)},
+		m_count{std::exchange(other.m_count, 0)} {}
+
+number_map &number_map::operator=(number_map &&other) noexcept
+{
+	if(this != &other) {
+		close();
+
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_count = std::exchange(other.m_count, 0);
+	}
+
+	return *this;
+}
+
+number_map::~number_map()
+{
+	close();
+}
+
+
+
+//-ACCESSORS-----------------------------------------------------------------------------------------------------------
+
+number_view number_map::operator[](size_t index) const noexcept
+{
+	uint64_t offset;
+	std::memcpy(&offset, m_data + sizeof(FileHeader) + index * sizeof(uint64_t), sizeof(offset));
+
+	if(offset % Alignment || offset > m_size || m_size - offset < sizeof(RecordHeader))
+		return number_view();
+
+	RecordHeader header;
+	std::memcpy(&header, m_data + offset, sizeof(header));
+
+	if(recordSize(header.nomSize, header.denSize) > m_size - offset)
+		return number_view();
+
+	const auto nom = reinterpret_cast<const num_t *>(m_data + offset + sizeof(RecordHeader));
+
+	return number_view(Sign(bool(header.flags & PositiveFlag)),
+					   header.nomExp, number_view::chunks(nom, header.nomSize),
+					   header.denExp, number_view::chunks(nom + header.nomSize, header.denSize),
+					   header.flags & CanonicalFlag);
+}
+
+
+
+//-STATIC-METHODS------------------------------------------------------------------------------------------------------
+
+bool number_map::Write(std::ostream &stream, const number *values, size_t count)
+{
+	constexpr size_t MaxSize = std::numeric_limits<uint32_t>::max();
+
+	// Offsets of the records follow from their sizes, so the index is written before them
+	std::vector<uint64_t> offsets(count);
+	size_t offset = sizeof(FileHeader) + count * sizeof(uint64_t);
+
+	for(size_t index = 0; index < count; ++index) {
+		const size_t nomSize = values[index].nom().size(), denSize = values[index].den().size();
+
+		if(nomSize > MaxSize || denSize > MaxSize)
+			return false;
+
+		offsets[index] = offset;
+		offset += recordSize(nomSize, denSize);
+	}
+
+	FileHeader header = {};
+
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.chunkBytes = sizeof(num_t);
+	header.byteOrder = ByteOrder;
+	header.count = count;
+
+	// Index starts at a multiple of 8 bytes after the header, and so do the records after the index
+	stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	stream.write(reinterpret_cast<const char *>(offsets.data()), std::streamsize(count * sizeof(uint64_t)));
+
+	static constexpr char Padding[Alignment] = {};
+
+	for(size_t index = 0; index < count && stream; ++index) {
+		const number &value = values[index];
+		RecordHeader record = {};
+
+		record.flags = uint8_t((value.sign() == number::Positive ? PositiveFlag : 0) |
+							   (value.isCanonical() ? CanonicalFlag : 0));
+		record.nomSize = uint32_t(value.nom().size());
+		record.denSize = uint32_t(value.den().size());
+		record.nomExp = value.nomExp();
+		record.denExp = value.denExp();
+
+		const size_t chunkBytes = (value.nom().size() + value.den().size()) * sizeof(num_t);
+
+		stream.write(reinterpret_cast<const char *>(&record), sizeof(record));
+		stream.write(reinterpret_cast<const char *>(value.nom().data()), std::streamsize(value.nom().size() * sizeof(num_t)));
+		stream.write(reinterpret_cast<const char *>(value.den().data()), std::streamsize(value.den().size() * sizeof(num_t)));
+		stream.write(Padding, std::streamsize(alignUp(chunkBytes) - chunkBytes));
+	}
+
+	return bool(stream);
+}
+
+
+
+//-INTERNAL-HELPER-METHODS---------------------------------------------------------------------------------------------
+
+void number_map::close() noexcept
+{
+	if(m_data) {
+#if defined(_WIN32)
+		UnmapViewOfFile(m_data);
+#else
+		munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_count = 0;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "number.hpp"
+
+// Binary encoding of arrays of numbers, version 1
+//     All fields are in the byte order of the writer, and chunks are stored raw, so a file is read only where the
+//     chunk width and the byte order match the ones it was written with
+//
+//     Header of 24 bytes     magic "brnonum\0", uint16 version, uint8 chunk bytes, uint8 zero, uint32 0x01020304
+//                            in the writer's byte order, uint64 count of numbers
+//     Index                  uint64 byte offset of each record from the start of the file
+//     Records                uint8 flags (1 = positive sign, 2 = canonical form), 3 zero bytes, uint32 nominator size,
+//                            uint32 denominator size, 4 zero bytes, int64 nominator exponent, int64 denominator
+//                            exponent, then the chunks of the nominator and the denominator, padded with zeros to a
+//                            multiple of 8 bytes
+//
+//     Records start at multiples of 8 bytes, so the chunks in a mapped file are aligned and read in place
+
+// Read-only view of an encoded number, whose vectors point into the encoding
+class number_view {
+
+	//-TYPE-DEFINITIONS------------------------------------------------------------------------------------------------
+public:
+	using num_t = number::num_t;
+	using exp_t = number::exp_t;
+	using Sign = number::Sign;
+
+	// Contiguous read-only chunks of a vector, stored from the most significant like the vectors of a number
+	class chunks {
+		const num_t *m_data = nullptr;
+		size_t m_size = 0;
+
+	public:
+		chunks() noexcept = default;
+		chunks(const num_t *data, size_t size) noexcept : m_data{data}, m_size{size} {}
+
+		inline size_t size() const noexcept { return m_size; }
+		inline bool empty() const noexcept { return !m_size; }
+		inline const num_t *data() const noexcept { return m_data; }
+
+		inline const num_t &operator[](size_t index) const noexcept { return m_data[index]; }
+		inline const num_t &front() const noexcept { return m_data[0]; }
+		inline const num_t &back() const noexcept { return m_data[m_size - 1]; }
+
+		inline const num_t *begin() const noexcept { return m_data; }
+		inline const num_t *end() const noexcept { return m_data + m_size; }
+	};
+
+
+
+	//-MEMBER-DECLARATIONS---------------------------------------------------------------------------------------------
+private:
+	chunks m_nom, m_den;
+	exp_t m_nomExp = number::DefaultExponent;
+	exp_t m_denExp = number::DefaultExponent;
+	Sign m_sign = number::DefaultSign;
+	bool m_canonical = false;
+
+
+
+	//-CONSTRUCTORS----------------------------------------------------------------------------------------------------
+public:
+	// View of an Undefined value
+	number_view() noexcept = default;
+
+	number_view(Sign sign, exp_t nomExp, chunks nom, exp_t denExp, chunks den, bool canonical) noexcept :
+			m_nom{nom},
+			m_den{den},
+			m_nomExp{nomExp},
+			m_denExp{denExp},
+			m_sign{sign},
+			m_canonical{canonical} {}
+
+
+
+	//-MEMBER-ACCESSORS------------------------------------------------------------------------------------------------
+
+	inline chunks nom() const noexcept { return m_nom; }
+	inline chunks den() const noexcept { return m_den; }
+	inline exp_t exp() const noexcept { return m_nomExp - m_denExp; }
+	inline exp_t nomExp() const noexcept { return m_nomExp; }
+	inline exp_t denExp() const noexcept { return m_denExp; }
+	inline Sign sign() const noexcept { return m_sign; }
+	inline bool isCanonical() const noexcept { return m_canonical; }
+
+	inline bool isZero() const noexcept { return m_nom.empty() & !m_den.empty(); }
+	inline bool isNonZero() const noexcept { return !m_nom.empty(); }
+	inline bool isNaN() const noexcept { return !m_nom.empty() & m_den.empty(); }
+	inline bool isNotNaN() const noexcept { return !m_den.empty(); }
+	inline bool isUndefined() const noexcept { return m_nom.empty() & m_den.empty(); }
+
+
+
+	//-CONVERSION-MEMBER-FUNCTIONS-------------------------------------------------------------------------------------
+
+	// Copies the value into a number, which is canonical only if it is marked so and its reduction confirms it
+	number toNumber() const;
+};
+
+
+
+// Read-only array of numbers in a memory mapped file of their binary encoding
+//     Opening a file reads only its header, the records are paged in when their views are read
+class number_map {
+
+	//-CONSTANT-DEFINITIONS--------------------------------------------------------------------------------------------
+public:
+	// Version of the encoding written, and the only one read
+	static constexpr uint16_t Version = 1;
+
+
+
+	//-MEMBER-DECLARATIONS---------------------------------------------------------------------------------------------
+private:
+	const unsigned char *m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_count = 0;
+
+
+
+	//-CONSTRUCTORS-&-ASSIGNMENTS--------------------------------------------------------------------------------------
+public:
+	number_map() noexcept = default;
+
+	// Maps the file at path, the map stays closed if it can not be mapped or does not hold a valid encoding
+	explicit number_map(const char *path);
+
+	number_map(const number_map &) = delete;
+	number_map &operator=(const number_map &) = delete;
+
+	number_map(number_map &&other) noexcept;
+	number_map &operator=(number_map &&other) noexcept;
+
+	~number_map();
+
+
+
+	//-ACCESSORS-------------------------------------------------------------------------------------------------------
+
+	inline bool isOpen() const noexcept { return m_data; }
+	explicit inline operator bool() const noexcept { return isOpen(); }
+
+	inline size_t size() const noexcept { return m_count; }
+
+	// View of the number at index, a record that does not fit in the file is viewed as Undefined
+	number_view operator[](size_t index) const noexcept;
+
+
+
+	//-STATIC-METHODS--------------------------------------------------------------------------------------------------
+
+	// Writes the encoding of count values into stream, and returns false if it fails
+	static bool Write(std::ostream &stream, const number *values, size_t count);
+
+
+
+	//-INTERNAL-HELPER-METHODS-----------------------------------------------------------------------------------------
+private:
+	void close() noexcept;
+};
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Contiguous vector of trivially copyable values that keeps up to InlineSize of them inside the object,
+// and spills to the heap only when it grows past that
+//     Values are a view into the storage, so removing them from the front only moves the view, and the freed
+//     space in front of them is reused when values are inserted at the front again
+template<typename T, size_t InlineSize>
+class small_vector {
+
+	static_assert(std::is_trivially_copyable<T>::value, "small_vector stores values by copying their bytes");
+	static_assert(InlineSize > 0, "small_vector needs inline storage");
+
+	//-TYPE-DEFINITIONS------------------------------------------------------------------------------------------------
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T &;
+	using const_reference = const T &;
+	using pointer = T *;
+	using const_pointer = const T *;
+	using iterator = T *;
+	using const_iterator = const T *;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+
+	//-MEMBER-DECLARATIONS---------------------------------------------------------------------------------------------
+private:
+
+	// Storage is either m_inline or a heap block of m_capacity values
+	T *m_storage = m_inline;
+	size_t m_capacity = InlineSize;
+
+	// Values are placed at m_data inside the storage
+	T *m_data = m_inline;
+	size_t m_size = 0;
+
+	T m_inline[InlineSize];
+
+
+
+	//-CONSTRUCTORS-&-ASSIGNMENTS--------------------------------------------------------------------------------------
+public:
+	small_vector() noexcept = default;
+
+	explicit small_vector(size_t size) : small_vector(size, T{}) {}
+
+	small_vector(size_t size, const T &value)
+	{
+		assign(size, value);
+	}
+
+	small_vector(std::initializer_list<T> values)
+	{
+		copyFrom(values.begin(), values.size());
+	}
+
+	small_vector(const small_vector &other)
+	{
+		copyFrom(other.m_data, other.m_size);
+	}
+
+	small_vector(small_vector &&other) noexcept
+	{
+		moveFrom(other);
+	}
+
+	small_vector &operator=(const small_vector &other)
+	{
+		if(this != &other) {
+			clear();
+			copyFrom(other.m_data, other.m_size);
+		}
+
+		return *this;
+	}
+
+	small_vector &operator=(small_vector &&other) noexcept
+	{
+		if(this != &other) {
+			release();
+			moveFrom(other);
+		}
+
+		return *this;
+	}
+
+	~small_vector()
+	{
+		release();
+	}
+
+
+
+	//-ACCESSORS-------------------------------------------------------------------------------------------------------
+
+	inline size_t size() const noexcept { return m_size; }
+	inline size_t capacity() const noexcept { return m_capacity - headroom(); }
+	inline bool empty() const noexcept { return !m_size; }
+	inline bool isInline() const noexcept { return m_storage == m_inline; }
+
+	inline T *data() noexcept { return m_data; }
+	inline const T *data() const noexcept { return m_data; }
+
+	inline T &operator[](size_t index) noexcept { return m_data[index]; }
+	inline const T &operator[](size_t index) const noexcept { return m_data[index]; }
+
+	inline T &front() noexcept { return m_data[0]; }
+	inline const T &front() const noexcept { return m_data[0]; }
+	inline T &back() noexcept { return m_data[m_size - 1]; }
+	inline const T &back() const noexcept { return m_data[m_size - 1]; }
+
+	inline iterator begin() noexcept { return m_data; }
+	inline const_iterator begin() const noexcept { return m_data; }
+	inline iterator end() noexcept { return m_data + m_size; }
+	inline const_iterator end() const noexcept { return m_data + m_size; }
+
+	inline reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	inline const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	inline reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	inline const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+
+
+	//-MODIFIERS-------------------------------------------------------------------------------------------------------
+
+	// The view is reset to the start of the storage, which makes the whole storage available again
+	inline void clear() noexcept
+	{
+		m_data = m_storage;
+		m_size = 0;
+	}
+
+	void reserve(size_t capacity)
+	{
+		grow(capacity);
+	}
+
+	void assign(size_t size, const T &value)
+	{
+		clear();
+		grow(size);
+		std::fill(m_data, m_data + size, value);
+		m_size = size;
+	}
+
+	// The range must not lie inside the vector itself
+	void assign(const_iterator first, const_iterator last)
+	{
+		clear();
+		copyFrom(first, size_t(last - first));
+	}
+
+	// New values are value-initialized
+	void resize(size_t size)
+	{
+		if(size > m_size) {
+			grow(size);
+			std::fill(m_data + m_size, m_data + size, T{});
+		}
+
+		m_size = size;
+	}
+
+	void push_back(const T &value)
+	{
+		const T copy = value;
+
+		grow(m_size + 1);
+		m_data[m_size++] = copy;
+	}
+
+	inline void pop_back() noexcept { --m_size; }
+
+	iterator insert(const_iterator position, size_t count, const T &value)
+	{
+		const size_t index = size_t(position - m_data);
+		const T copy = value;
+
+		// Values in front of the position are moved into the headroom when there is enough of it
+		if(index <= m_size - index && count <= headroom()) {
+			std::memmove(m_data - count, m_data, index * sizeof(T));
+			m_data -= count;
+		}
+		else {
+			grow(m_size + count);
+			std::memmove(m_data + index + count, m_data + index, (m_size - index) * sizeof(T));
+		}
+
+		std::fill(m_data + index, m_data + index + count, copy);
+		m_size += count;
+
+		return m_data + index;
+	}
+
+	// Values are closed up from the shorter side, so erasing from the front only moves the view
+	iterator erase(const_iterator first, const_iterator last) noexcept
+	{
+		const size_t
+				index = size_t(first - m_data),
+				count = size_t(last - first),
+				after = m_size - index - count;
+
+		if(index < after) {
+			std::memmove(m_data + count, m_data, index * sizeof(T));
+			m_data += count;
+		}
+		else
+			std::memmove(m_data + index, m_data + index + count, after * sizeof(T));
+
+		m_size -= count;
+
+		return m_data + index;
+	}
+
+	inline iterator erase(const_iterator position) noexcept { return erase(position, position + 1); }
+
+
+
+	//-COMPARISON-OPERATORS--------------------------------------------------------------------------------------------
+	// Lexicographical, same as for std::vector
+
+	friend bool operator==(const small_vector &left, const small_vector &right)
+	{
+		return std::equal(left.begin(), left.end(), right.begin(), right.end());
+	}
+	friend bool operator!=(const small_vector &left, const small_vector &right) { return !(left == right); }
+
+	friend bool operator<(const small_vector &left, const small_vector &right)
+	{
+		return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+	}
+	friend bool operator>(const small_vector &left, const small_vector &right) { return right < left; }
+	friend bool operator<=(const small_vector &left, const small_vector &right) { return !(right < left); }
+	friend bool operator>=(const small_vector &left, const small_vector &right) { return !(left < right); }
+
+
+
+	//-INTERNAL-HELPER-METHODS-----------------------------------------------------------------------------------------
+private:
+
+	inline size_t headroom() const noexcept { return size_t(m_data - m_storage); }
+
+	// Makes room for at least size values after the start of the view
+	//     Values are moved back to the start of the storage if it is at most half full, otherwise the storage grows
+	//     geometrically, so that repeated insertions stay amortized constant
+	void grow(size_t size)
+	{
+		if(size <= capacity())
+			return;
+		else if(2 * size <= m_capacity) {
+			std::memmove(m_storage, m_data, m_size * sizeof(T));
+			m_data = m_storage;
+		}
+		else
+			reallocate(std::max(size, 2 * m_capacity));
+	}
+
+	void reallocate(size_t capacity)
+	{
+		T *const storage = std::allocator<T>().allocate(capacity);
+
+		std::memcpy(storage, m_data, m_size * sizeof(T));
+		release();
+
+		m_storage = m_data = storage;
+		m_capacity = capacity;
+	}
+
+	void release() noexcept
+	{
+		if(!isInline())
+			std::allocator<T>().deallocate(m_storage, m_capacity);
+
+		m_storage = m_data = m_inline;
+		m_capacity = InlineSize;
+	}
+
+	// Expects an empty vector
+	void copyFrom(const T *values, size_t size)
+	{
+		grow(size);
+		std::memcpy(m_data, values, size * sizeof(T));
+		m_size = size;
+	}
+
+	// Expects a released vector, steals the storage of other or copies its inline values
+	void moveFrom(small_vector &other) noexcept
+	{
+		if(other.isInline())
+			std::memcpy(m_inline, other.m_data, other.m_size * sizeof(T));
+		else {
+			m_storage = other.m_storage;
+			m_capacity = other.m_capacity;
+			m_data = other.m_data;
+
+			other.m_storage = other.m_data = other.m_inline;
+			other.m_capacity = InlineSize;
+		}
+
+		m_size = other.m_size;
+		other.m_size = 0;
+	}
+};
@@ -0,0 +1,565 @@
+#include "number_map.hpp"
+
+#include <climits>
+#include <cstdio>
+#include <random>
+
+using Sign = number::Sign;
+using Reduction = number::Reduction;
+
+using data_t = number::data_t;
+
+// Differential checks of the integer arithmetic against a plain schoolbook implementation over 32-bit limbs, and
+// checks that the reduction policies agree on fractions
+//     The operand sizes straddle the thresholds between the multiplication and division algorithms of the chunk width
+//     the test is built for, a failed check prints its operands and the test exits with a non-zero status
+
+
+
+//-REFERENCE-ARITHMETIC------------------------------------------------------------------------------------------------
+//    Natural numbers as vectors of 32-bit limbs from the least significant, without leading zero limbs
+
+
+using limbs_t = std::vector<uint32_t>;
+
+static void trim(limbs_t &value)
+{
+	while(!value.empty() && !value.back())
+		value.pop_back();
+}
+
+static int compare(const limbs_t &left, const limbs_t &right)
+{
+	if(left.size() != right.size())
+		return left.size() < right.size() ? -1 : 1;
+
+	for(size_t index = left.size(); index--;) {
+		if(left[index] != right[index])
+			return left[index] < right[index] ? -1 : 1;
+	}
+
+	return 0;
+}
+
+static limbs_t add(const limbs_t &left, const limbs_t &right)
+{
+	limbs_t result(std::max(left.size(), right.size()) + 1);
+	uint64_t carry = 0;
+
+	for(size_t index = 0; index < result.size(); ++index) {
+		carry += index < left.size() ? left[index] : 0;
+		carry += index < right.size() ? right[index] : 0;
+		result[index] = uint32_t(carry);
+		carry >>= 32u;
+	}
+
+	trim(result);
+	return result;
+}
+
+// left - right, where left >= right
+static limbs_t sub(const limbs_t &left, const limbs_t &right)
+{
+	limbs_t result(left.size());
+	int64_t borrow = 0;
+
+	for(size_t index = 0; index < left.size(); ++index) {
+		int64_t difference = int64_t(left[index]) - (index < right.size() ? int64_t(right[index]) : 0) - borrow;
+		borrow = difference < 0;
+		result[index] = uint32_t(difference + (borrow ? int64_t(1) << 32u : 0));
+	}
+
+	trim(result);
+	return result;
+}
+
+static limbs_t mul(const limbs_t &left, const limbs_t &right)
+{
+	limbs_t result(left.size() + right.size());
+
+	for(size_t leftIndex = 0; leftIndex < left.size(); ++leftIndex) {
+		uint64_t carry = 0;
+
+		for(size_t rightIndex = 0; rightIndex < right.size(); ++rightIndex) {
+			carry += uint64_t(left[leftIndex]) * right[rightIndex] + result[leftIndex + rightIndex];
+			result[leftIndex + rightIndex] = uint32_t(carry);
+			carry >>= 32u;
+		}
+
+		result[leftIndex + right.size()] = uint32_t(carry);
+	}
+
+	trim(result);
+	return result;
+}
+
+static size_t bitLength(const limbs_t &value)
+{
+	if(value.empty())
+		return 0;
+
+	size_t bits = 32 * value.size();
+
+	for(uint32_t top = value.back(); !(top >> 31u); top <<= 1u)
+		--bits;
+
+	return bits;
+}
+
+// Quotient and remainder of a division by a non-zero divisor, one bit at a time
+static void divmod(limbs_t &quotient, limbs_t &remainder, const limbs_t &num, const limbs_t &divisor)
+{
+	quotient.assign(num.size(), 0);
+	remainder.clear();
+
+	for(size_t bit = bitLength(num); bit--;) {
+		// remainder = 2 * remainder + the next bit of num
+		remainder.push_back(0);
+
+		for(size_t index = remainder.size(); --index;)
+			remainder[index] = (remainder[index] << 1u) | (remainder[index - 1] >> 31u);
+
+		remainder[0] = (remainder[0] << 1u) | ((num[bit / 32] >> (bit % 32)) & 1u);
+		trim(remainder);
+
+		if(compare(remainder, divisor) >= 0) {
+			remainder = sub(remainder, divisor);
+			quotient[bit / 32] |= uint32_t(1) << (bit % 32);
+		}
+	}
+
+	trim(quotient);
+}
+
+static std::string toHex(const limbs_t &value)
+{
+	static constexpr char Digits[] = "0123456789abcdef";
+
+	if(value.empty())
+		return "0";
+
+	std::string text;
+
+	for(size_t index = value.size(); index--;) {
+		for(unsigned shift = 32; shift;) {
+			shift -= 4;
+			text.push_back(Digits[(value[index] >> shift) & 15u]);
+		}
+	}
+
+	return text.substr(text.find_first_not_of('0'));
+}
+
+
+// Signed integer of the reference arithmetic
+struct Integer {
+	bool negative;
+	limbs_t magnitude;
+};
+
+static Integer negate(Integer value)
+{
+	value.negative = !value.negative && !value.magnitude.empty();
+	return value;
+}
+
+static Integer add(const Integer &left, const Integer &right)
+{
+	if(left.negative == right.negative)
+		return {left.negative, add(left.magnitude, right.magnitude)};
+
+	const int order = compare(left.magnitude, right.magnitude);
+
+	if(!order)
+		return {false, {}};
+	else if(order > 0)
+		return {left.negative, sub(left.magnitude, right.magnitude)};
+	else
+		return {right.negative, sub(right.magnitude, left.magnitude)};
+}
+
+static Integer mul(const Integer &left, const Integer &right)
+{
+	limbs_t magnitude = mul(left.magnitude, right.magnitude);
+	return {(left.negative != right.negative) && !magnitude.empty(), magnitude};
+}
+
+// Quotient rounded toward zero and the remainder with the sign of num, as number::Trunc and operator% give them
+static void divmod(Integer &quotient, Integer &remainder, const Integer &num, const Integer &divisor)
+{
+	divmod(quotient.magnitude, remainder.magnitude, num.magnitude, divisor.magnitude);
+
+	quotient.negative = (num.negative != divisor.negative) && !quotient.magnitude.empty();
+	remainder.negative = num.negative && !remainder.magnitude.empty();
+}
+
+static int compare(const Integer &left, const Integer &right)
+{
+	if(left.negative != right.negative)
+		return left.negative ? -1 : 1;
+
+	const int order = compare(left.magnitude, right.magnitude);
+	return left.negative ? -order : order;
+}
+
+static std::string toHex(const Integer &value)
+{
+	return (value.negative ? "-" : "") + toHex(value.magnitude);
+}
+
+static number toNumber(const Integer &value)
+{
+	return number(toHex(value), 16);
+}
+
+
+
+//-CHECKS--------------------------------------------------------------------------------------------------------------
+
+static size_t failures = 0;
+
+static void check(bool passed, const char *what, const Integer &left, const Integer &right)
+{
+	if(!passed) {
+		if(++failures <= 16)
+			std::printf("FAILED %s\n    left:  %s\n    right: %s\n", what, toHex(left).c_str(), toHex(right).c_str());
+	}
+}
+
+static void check(bool passed, const char *what)
+{
+	if(!passed && ++failures <= 16)
+		std::printf("FAILED %s\n", what);
+}
+
+static bool matches(const number &value, const Integer &expected)
+{
+	return value.toString(0, 16) == toHex(expected);
+}
+
+
+static std::mt19937_64 generator(0x62726e6f);
+
+// Random magnitude of size chunks of the tested width, whose chunks are random, all ones, or mostly zero, so that the
+// carries run through whole buffers
+static limbs_t randomLimbs(size_t chunks)
+{
+	const size_t size = chunks * (number::ChunkBits / 32);
+	limbs_t value(size);
+
+	switch(generator() % 4) {
+		case 0:
+			std::fill(value.begin(), value.end(), ~uint32_t(0));
+			break;
+
+		case 1:
+			value.back() = 1;
+			break;
+
+		default:
+			for(auto &limb : value)
+				limb = uint32_t(generator());
+	}
+
+	value.back() |= uint32_t(1) << 31u;
+	return value;
+}
+
+static Integer randomInteger(size_t chunks)
+{
+	return {bool(generator() & 1u), randomLimbs(chunks)};
+}
+
+
+// Checks the integer operations of left and right against the reference
+static void checkIntegers(const Integer &left, const Integer &right, bool divide)
+{
+	const number
+			leftNumber = toNumber(left),
+			rightNumber = toNumber(right);
+
+	check(matches(leftNumber, left), "radix 16 round trip", left, right);
+	check(number(leftNumber.toString(), 10) == leftNumber, "radix 10 round trip", left, right);
+
+	check(matches(leftNumber + rightNumber, add(left, right)), "left + right", left, right);
+	check(matches(leftNumber - rightNumber, add(left, negate(right))), "left - right", left, right);
+	check(matches(leftNumber * rightNumber, mul(left, right)), "left * right", left, right);
+	check(matches(leftNumber * leftNumber, mul(left, left)), "left * left", left, right);
+
+	const int order = compare(left, right);
+
+	check((leftNumber < rightNumber) == (order < 0), "left < right", left, right);
+	check((leftNumber == rightNumber) == !order, "left == right", left, right);
+	check((leftNumber > rightNumber) == (order > 0), "left > right", left, right);
+
+	if(divide && !right.magnitude.empty()) {
+		Integer quotient, remainder;
+		divmod(quotient, remainder, left, right);
+
+		check(matches(number::Trunc(leftNumber / rightNumber), quotient), "trunc(left / right)", left, right);
+		check(matches(leftNumber % rightNumber, remainder), "left % right", left, right);
+	}
+}
+
+
+// Sizes in chunks around a threshold
+static void addAround(std::vector<size_t> &sizes, size_t threshold)
+{
+	sizes.insert(sizes.end(), {threshold - 1, threshold, threshold + 1});
+}
+
+static void checkMultiplicationTiers()
+{
+	std::vector<size_t> sizes = {1, 2, 3, 4, 5, 7, 8, 9, 16};
+
+	addAround(sizes, number::KaratsubaThreshold);
+	addAround(sizes, number::KaratsubaSquareThreshold);
+	addAround(sizes, number::Toom3Threshold);
+	addAround(sizes, number::Toom3SquareThreshold);
+	addAround(sizes, number::NttThreshold);
+
+	for(const size_t size : sizes) {
+		checkIntegers(randomInteger(size), randomInteger(size), false);
+
+		// Unbalanced operands split the larger one into slices
+		checkIntegers(randomInteger(size), randomInteger(size / 3 + 1), false);
+		checkIntegers(randomInteger(size / 3 + 1), randomInteger(2 * size + 5), false);
+	}
+}
+
+static void checkDivision()
+{
+	std::vector<size_t> sizes = {1, 2, 3, 5, 8, 17};
+
+	addAround(sizes, number::BurnikelZieglerThreshold);
+	addAround(sizes, 2 * number::BurnikelZieglerThreshold);
+
+	for(const size_t size : sizes) {
+		for(const size_t numSize : {size, size + 1, 2 * size, 3 * size + 2})
+			checkIntegers(randomInteger(numSize), randomInteger(size), true);
+	}
+
+	// Quotients of a single chunk, and divisors of all ones
+	const Integer ones{false, limbs_t(8 * (number::ChunkBits / 32), ~uint32_t(0))};
+
+	checkIntegers(add(ones, {false, {1}}), ones, true);
+	checkIntegers(mul(ones, ones), ones, true);
+}
+
+
+// Fraction of random integers of up to size chunks
+static number randomFraction(size_t size)
+{
+	const number
+			nom = toNumber(randomInteger(generator() % size + 1)),
+			den = toNumber({false, randomLimbs(generator() % size + 1)});
+
+	return nom / den;
+}
+
+// Evaluates an expression of fractions under the policy, normalized for the comparison
+static number evaluate(Reduction policy, const number &a, const number &b, const number &c)
+{
+	number::setReduction(policy);
+
+	number result = (a + b) * c - a / (b * b + c * c);
+	result += a * b;
+	result /= c * c + 1;
+	result -= 3;
+
+	number::setReduction(number::DefaultReduction);
+	return result.normalize();
+}
+
+static void checkReductionPolicies()
+{
+	for(size_t round = 0; round < 64; ++round) {
+		const size_t size = round < 48 ? 4 : 40;
+
+		const number
+				a = randomFraction(size),
+				b = randomFraction(size),
+				c = randomFraction(size);
+
+		const number expected = evaluate(Reduction::Always, a, b, c);
+
+		check(expected.isCanonical(), "Always gives a canonical result");
+		check(evaluate(Reduction::Never, a, b, c) == expected, "Never agrees with Always");
+		check(evaluate(Reduction::Lazy, a, b, c) == expected, "Lazy agrees with Always");
+		check((expected * c) / c == expected, "(x * c) / c == x");
+	}
+
+	// Partial sums of the harmonic series outgrow the smallest lazy reduction size many times
+	number sums[3] = {0, 0, 0};
+	const Reduction policies[3] = {Reduction::Never, Reduction::Lazy, Reduction::Always};
+
+	for(size_t index = 0; index < 3; ++index) {
+		number::setReduction(policies[index]);
+
+		for(int term = 1; term <= 400; ++term)
+			sums[index] += number(1) / number(term);
+
+		number::setReduction(number::DefaultReduction);
+		sums[index].normalize();
+	}
+
+	check(sums[0] == sums[2] && sums[1] == sums[2], "harmonic sums agree across the policies");
+}
+
+
+// Numbers given with zero chunks around their vectors
+static void checkUntruncatedOperands()
+{
+	const number
+			padded(Sign::Positive, 2, data_t{0, 1, 0}, 2, data_t{0, 3, 0}),
+			third = number(1) / number(3);
+
+	check(padded == third, "padded 1 / 3 equals 1 / 3");
+	check(padded / padded == number(1), "padded / padded == 1");
+	check(padded * padded == third * third, "padded * padded");
+	check(padded + padded == third + third, "padded + padded");
+	check(number(Sign::Positive, 1, data_t{0, 0}, 0, data_t{1}).isZero(), "zero chunks give zero");
+	check(number(Sign::Positive, 1, data_t{1}, 0, data_t{0}).isNaN(), "zero chunks of the denominator give NaN");
+}
+
+
+// Operations with machine integers, which take the chunk kernels, against the same operations on their numbers
+static void checkIntegerOperands()
+{
+	const number third = number(1) / number(3);
+
+	const number values[] = {
+			number::Zero(), number::NaN(), number::Undefined(), third, -third, number(5), number(-7),
+			number(7) / number(2), third * third * 1000000007, -number::Power(number(2), number::ChunkBits) / 3,
+			toNumber(randomInteger(3)) / toNumber({false, randomLimbs(2)})
+	};
+	const int64_t integers[] = {0, 1, -1, 3, 5, -7, INT32_MAX, INT64_MIN, INT64_MAX};
+
+	// Undefined equals nothing, not even itself
+	const auto same = [](const number &left, const number &right) {
+		return (left.isUndefined() && right.isUndefined()) || left == right;
+	};
+
+	for(const Reduction policy : {Reduction::Never, Reduction::Lazy, Reduction::Always}) {
+		number::setReduction(policy);
+
+		for(const number &value : values) {
+			for(const int64_t integer : integers) {
+				const number other(integer);
+
+				check(same(value + integer, value + other) && same(integer + value, other + value), "value + integer");
+				check(same(value - integer, value - other) && same(integer - value, other - value), "value - integer");
+				check(same(value * integer, value * other) && same(integer * value, other * value), "value * integer");
+				check(same(value / integer, value / other) && same(integer / value, other / value), "value / integer");
+
+				check(same(number(value) - integer, value - other), "temporary - integer");
+				check(same(integer - number(value), other - value), "integer - temporary");
+				check(same(integer / number(value), other / value), "integer / temporary");
+
+				check((value == integer) == (value == other) && (integer == value) == (other == value), "==");
+				check((value != integer) == (value != other) && (integer != value) == (other != value), "!=");
+				check((value < integer) == (value < other) && (integer < value) == (other < value), "<");
+				check((value <= integer) == (value <= other) && (integer <= value) == (other <= value), "<=");
+				check((value > integer) == (value > other) && (integer > value) == (other > value), ">");
+				check((value >= integer) == (value >= other) && (integer >= value) == (other >= value), ">=");
+			}
+		}
+	}
+
+	number::setReduction(number::DefaultReduction);
+
+	// The int constructor takes the magnitude of INT_MIN without overflowing
+	check(number(INT_MIN) == int64_t(INT_MIN) && number(INT_MIN) + 1 == -INT_MAX, "number(INT_MIN)");
+	check(number(INT_MIN).toString() == "-2147483648", "number(INT_MIN) printed");
+
+	check(number(UINT64_MAX) == UINT64_MAX && number(UINT64_MAX) > INT64_MAX, "integers wider than a chunk");
+}
+
+
+// Roots are correct to a number of binary digits, whatever radix they are printed in
+static void checkSquareRoots()
+{
+	for(const number::digits_t bits : {10u, 64u, 200u, 1000u}) {
+		for(const int square : {2, 3, 1000003}) {
+			const number root = number(square).sqrt(bits), error = root * root - square;
+
+			// The square of a root of relative error 2^-bits has a relative error of about 2^(1 - bits)
+			check(error * number::Power(number(2), bits - 2) / square < 1 &&
+				  error * number::Power(number(2), bits - 2) / square > -1, "root correct to its bits");
+		}
+	}
+}
+
+
+// Remainders are rounded to the precision like the results of the other operations, under every policy
+static void checkRoundedRemainders()
+{
+	const number
+			left = number(1000003) / number(7),
+			right = number(1) / number(3),
+			exact = left % right;
+
+	const Reduction policies[3] = {Reduction::Never, Reduction::Lazy, Reduction::Always};
+	number remainders[3];
+
+	number::setPrecision(1);
+
+	for(size_t index = 0; index < 3; ++index) {
+		number::setReduction(policies[index]);
+		remainders[index] = left % right;
+	}
+
+	number::setReduction(number::DefaultReduction);
+	number::setPrecision(0);
+
+	// The exact remainder has a denominator of 21, which no chunk of binary digits represents
+	for(const number &remainder : remainders) {
+		const number error = (remainder - exact) / exact * number::Power(number(2), number::ChunkBits - 1);
+
+		check(remainder.isCanonical() && remainder != exact && error < 1 && error > -1,
+			  "remainder rounded to the precision");
+	}
+}
+
+
+// Views of encodings whose records are neither truncated nor reduced, although one is marked canonical
+static void checkViews()
+{
+	const number::num_t nom[] = {0, 2, 0}, den[] = {4, 0};
+	const number half = number(1) / number(2);
+
+	for(const bool canonical : {true, false}) {
+		const number value = number_view(Sign::Positive, 2, {nom, 3}, 1, {den, 2}, canonical).toNumber();
+
+		check(value == half, "view of 2 / 4 equals 1 / 2");
+		check(value / value == number(1), "view divided by itself");
+		check(value.isCanonical() == canonical, "view is canonical only when marked so and reduced");
+	}
+
+	const number marked = number_view(Sign::Positive, 2, {nom, 3}, 1, {den, 2}, true).toNumber();
+	check(marked.nom() == half.nom() && marked.den() == half.den(), "view marked canonical is reduced");
+}
+
+
+
+//-MAIN----------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+	checkMultiplicationTiers();
+	checkDivision();
+	checkReductionPolicies();
+	checkUntruncatedOperands();
+	checkIntegerOperands();
+	checkSquareRoots();
+	checkRoundedRemainders();
+	checkViews();
+
+	if(failures) {
+		std::printf("%zu checks failed with %u-bit chunks\n", failures, unsigned(number::ChunkBits));
+		return 1;
+	}
+
+	std::printf("All checks passed with %u-bit chunks\n", unsigned(number::ChunkBits));
+	return 0;
+}
@@ -0,0 +1,268 @@
+// The buffer kernels are internal to the translation unit, so it is compiled into the test
+#include "number.cpp"
+
+#include <cstdio>
+#include <random>
+
+// Checks of the buffer kernels on random and edge case inputs, of lengths from a single chunk over every remainder of
+// the ADX blocks
+//     Where the ADX kernels are built and the processor supports them, every result and carry is compared with the one
+//     of the portable loops on the same inputs, in both builds the kernels are checked against each other
+
+
+
+//-INPUTS--------------------------------------------------------------------------------------------------------------
+
+static std::mt19937_64 generator(0x61647863);
+
+enum class Pattern {
+	Random,
+	// Every chunk all ones, so carries and borrows run through the whole buffer
+	Ones,
+	Zeros,
+	// Ones in the low chunks and random high chunks
+	OnesBelow
+};
+
+static constexpr Pattern Patterns[] = {Pattern::Random, Pattern::Ones, Pattern::Zeros, Pattern::OnesBelow};
+
+static data_t buffer(size_t count, Pattern pattern)
+{
+	data_t vec(count);
+
+	for(size_t index = 0; index < count; ++index) {
+		switch(pattern) {
+			case Pattern::Random:
+				vec[index] = num_t(generator());
+				break;
+			case Pattern::Ones:
+				vec[index] = ~num_t(0);
+				break;
+			case Pattern::Zeros:
+				vec[index] = 0;
+				break;
+			case Pattern::OnesBelow:
+				vec[index] = index >= count / 2 ? ~num_t(0) : num_t(generator());
+				break;
+		}
+	}
+
+	return vec;
+}
+
+// Chunks multiplied by the buffers, including the extremes
+static num_t value(size_t round)
+{
+	switch(round % 4) {
+		case 0:
+			return ~num_t(0);
+		case 1:
+			return 1;
+		case 2:
+			return num_t(1) << (number::ChunkBits - 1);
+		default:
+			return num_t(generator());
+	}
+}
+
+
+
+//-CHECKS--------------------------------------------------------------------------------------------------------------
+
+static size_t failures = 0, comparisons = 0;
+
+static void check(bool passed, const char *what, size_t count)
+{
+	if(!passed && ++failures <= 16)
+		std::printf("FAILED %s of %zu chunks\n", what, count);
+}
+
+
+// Output buffer and returned carry of a kernel
+struct Output {
+	data_t dest;
+	result_t carry;
+
+	inline bool operator==(const Output &other) const
+	{
+		return carry == other.carry && dest.size() == other.dest.size() &&
+			   std::equal(dest.begin(), dest.end(), other.dest.begin());
+	}
+};
+
+// Runs the kernel once, and once more on the portable loops where the ADX kernels are available, and checks that the
+// outputs match
+template<typename Kernel>
+static Output run(const char *what, size_t count, const Kernel &kernel)
+{
+	const Output output = kernel();
+
+#if BRNO_NUMBER_ADX
+	if(HasAdx) {
+		HasAdx = false;
+		const Output portable = kernel();
+		HasAdx = true;
+
+		check(output == portable, what, count);
+		++comparisons;
+	}
+#else
+	static_cast<void>(what);
+	static_cast<void>(count);
+#endif
+
+	return output;
+}
+
+
+static void checkAdditions(size_t count, Pattern leftPattern, Pattern rightPattern)
+{
+	const data_t left = buffer(count, leftPattern), right = buffer(count, rightPattern);
+
+	for(const result_t carry : {result_t(0), result_t(1)}) {
+		const Output
+				sum = run("rsum", count, [&] {
+					data_t dest = left;
+					const result_t overflow = rsum(rptr(dest), rptr(right), count, carry);
+					return Output{dest, overflow};
+				}),
+				difference = run("rsub", count, [&] {
+					data_t dest(count);
+					const auto borrow = result_t(rsub(rptr(dest), rptr(left), rptr(right), count, sresult_t(carry)));
+					return Output{dest, borrow};
+				}),
+				diff = run("rdiff", count, [&] {
+					data_t dest = left;
+					const auto borrow = result_t(rdiff(rptr(dest), rptr(right), count, sresult_t(carry)));
+					return Output{dest, borrow};
+				});
+
+		check(difference == diff, "rsub against rdiff", count);
+
+		// Adding right back to the difference gives left with the borrows cancelled by the carries
+		data_t restored = difference.dest;
+		const result_t carryOut = rsum(rptr(restored), rptr(right), count, carry);
+
+		check(Output{restored, carryOut} == Output{left, difference.carry}, "rsum of rsub", count);
+
+		// The carry of a sum is set exactly when the chunks wrapped around
+		data_t back = sum.dest;
+		const auto borrow = result_t(rdiff(rptr(back), rptr(right), count, sresult_t(carry)));
+
+		check(Output{back, borrow} == Output{left, sum.carry}, "rdiff of rsum", count);
+	}
+}
+
+static void checkMultiplications(size_t count, Pattern srcPattern, Pattern destPattern, size_t round)
+{
+	const data_t src = buffer(count, srcPattern), base = buffer(count, destPattern);
+	const num_t factor = value(round), carry = value(round / 4);
+
+	const Output
+			product = run("rmul", count, [&] {
+				data_t dest(count);
+				const num_t overflow = rmul(rptr(dest), rptr(src), count, factor, carry);
+				return Output{dest, overflow};
+			}),
+			productSum = run("rmuladd", count, [&] {
+				data_t dest = base;
+				const num_t overflow = rmuladd(rptr(dest), rptr(src), count, factor, carry);
+				return Output{dest, overflow};
+			}),
+			productDifference = run("rsubmul", count, [&] {
+				data_t dest = base;
+				const num_t overflow = rsubmul(rptr(dest), rptr(src), count, factor, carry);
+				return Output{dest, overflow};
+			});
+
+	// The product added to zeros is the product itself
+	data_t zeros(count);
+	const num_t overflow = rmuladd(rptr(zeros), rptr(src), count, factor, carry);
+
+	check(Output{zeros, overflow} == product, "rmuladd onto zeros against rmul", count);
+
+	// The product added to base is base plus the product, with the carry of the sum in the top chunk
+	data_t sum = base;
+	const result_t sumCarry = rsum(rptr(sum), rptr(product.dest), count);
+
+	check(Output{sum, product.carry + sumCarry} == productSum, "rmuladd against rmul and rsum", count);
+
+	// Subtracting the product from their sum restores base, when nothing carried in
+	data_t restored = productSum.dest;
+	const num_t borrow = rsubmul(rptr(restored), rptr(src), count, factor, carry);
+
+	check(Output{restored, borrow} == Output{base, productSum.carry}, "rsubmul of rmuladd", count);
+
+	// Adding the product back to the difference restores base as well
+	data_t back = productDifference.dest;
+	const num_t backCarry = rmuladd(rptr(back), rptr(src), count, factor, carry);
+
+	check(Output{back, backCarry} == Output{base, productDifference.carry}, "rmuladd of rsubmul", count);
+}
+
+static void checkProducts(size_t biggerSize, size_t smallerSize, Pattern pattern)
+{
+	const data_t bigger = buffer(biggerSize, pattern), smaller = buffer(smallerSize, Pattern::Random);
+
+	const Output product = run("rmul of buffers", biggerSize, [&] {
+		data_t dest(biggerSize + smallerSize);
+		rmul(rptr(dest), rptr(bigger), biggerSize, rptr(smaller), smallerSize);
+		return Output{dest, 0};
+	});
+
+	// Rows of the schoolbook product added one at a time
+	data_t expected(biggerSize + smallerSize), row(biggerSize + 1);
+
+	for(size_t index = 0; index < smallerSize; ++index) {
+		row.front() = rmul(rptr(row), rptr(bigger), biggerSize, smaller[smallerSize - 1 - index]);
+
+		num_t *const end = rptr(expected) - index;
+		const auto carry = num_t(rsum(end, rptr(row), biggerSize + 1));
+
+		if(index + biggerSize + 1 < expected.size())
+			rcarry(end - biggerSize - 1, expected.size() - index - biggerSize - 1, carry);
+	}
+
+	check(product == Output{expected, 0}, "rmul of buffers against rows", biggerSize);
+}
+
+
+
+//-MAIN----------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+	std::vector<size_t> counts;
+
+	// A single chunk and every remainder over the first blocks of four chunks, then long buffers
+	for(size_t count = 1; count <= 19; ++count)
+		counts.push_back(count);
+
+	counts.insert(counts.end(), {31, 32, 33, 63, 64, 65, 255, 257});
+
+	size_t round = 0;
+
+	for(const size_t count : counts) {
+		for(const Pattern left : Patterns) {
+			for(const Pattern right : Patterns) {
+				checkAdditions(count, left, right);
+				checkMultiplications(count, left, right, round++);
+			}
+
+			for(const size_t smaller : {size_t(1), size_t(2), size_t(5), count})
+				checkProducts(count, std::min(smaller, count), left);
+		}
+	}
+
+	if(failures) {
+		std::printf("%zu kernel checks failed\n", failures);
+		return 1;
+	}
+
+	if(comparisons)
+		std::printf("All kernel checks passed, %zu compared with the portable loops\n", comparisons);
+	else
+		std::printf("All kernel checks passed on the portable loops\n");
+
+	return 0;
+}
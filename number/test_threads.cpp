@@ -0,0 +1,148 @@
+#include "number.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+using Sign = number::Sign;
+
+using num_t = number::num_t;
+using exp_t = number::exp_t;
+
+using data_t = number::data_t;
+
+// Checks of the operations that fork lanes onto the pool, run from several threads at once
+//     A thread that waits for its lanes in the pool must not run the lanes of another thread inside of its operation,
+//     so the parallel results have to match the ones computed on a single thread, the test is built with a pool of a
+//     few workers so that the lanes are shared out even on a single core
+
+
+
+//-OPERANDS------------------------------------------------------------------------------------------------------------
+
+static std::mt19937_64 generator(0x706f6f6c);
+
+// Random positive integer of size chunks
+static number randomInteger(size_t size)
+{
+	data_t vec(size);
+
+	for(auto &chunk : vec)
+		chunk = num_t(generator());
+
+	vec.front() |= 1;
+
+	return number(Sign::Positive, exp_t(size), std::move(vec), 0, data_t{1}).normalize();
+}
+
+// Random fraction of chunks below the smallest parallel multiplication
+static number randomFraction()
+{
+	return randomInteger(generator() % 3 + 1) / randomInteger(generator() % 3 + 1);
+}
+
+
+
+//-CHECKS--------------------------------------------------------------------------------------------------------------
+
+static std::atomic<size_t> failures{0};
+
+static void check(bool passed, const char *what)
+{
+	if(!passed && ++failures <= 16)
+		std::printf("FAILED %s\n", what);
+}
+
+
+// Large multiplications on one thread, whose lanes wait for the pool while the body runs rounds times on this one
+template<typename Body>
+static void runAlongsideMultiplications(size_t rounds, const Body &body)
+{
+	const number
+			left = randomInteger(3000),
+			right = randomInteger(3000);
+
+	number::setThreads(1);
+	const number expected = left * right;
+	number::setThreads(number::DefaultThreads);
+
+	std::atomic<bool> done{false};
+
+	std::thread multiplications([&] {
+		for(size_t round = 0; !done; ++round) {
+			number::setThreads(round % 3 + 2);
+			check(left * right == expected, "product alongside the other thread");
+		}
+	});
+
+	for(size_t round = 0; round < rounds; ++round) {
+		number::setThreads(round % 3 + 2);
+		body();
+	}
+
+	done = true;
+	number::setThreads(number::DefaultThreads);
+	multiplications.join();
+}
+
+
+// Batch rows run as lanes of the pool
+static void checkBatches()
+{
+	constexpr size_t Count = 4000;
+
+	std::vector<number> left(Count), right(Count), expected(Count), result(Count);
+
+	for(size_t index = 0; index < Count; ++index) {
+		left[index] = randomFraction();
+		right[index] = randomFraction();
+		expected[index] = left[index] + right[index];
+	}
+
+	runAlongsideMultiplications(24, [&] {
+		number::Add(result.data(), left.data(), right.data(), Count);
+		check(std::equal(result.begin(), result.end(), expected.begin()), "batch sums alongside a product");
+	});
+}
+
+
+// Halves of the trees run as lanes of the pool
+static void checkTrees()
+{
+	constexpr size_t Count = 1500;
+
+	std::vector<number> values(Count);
+
+	for(auto &value : values)
+		value = randomInteger(10);
+
+	number::setThreads(1);
+	const number
+			sum = number::Sum(values.data(), Count),
+			product = number::Product(values.data(), Count);
+	number::setThreads(number::DefaultThreads);
+
+	runAlongsideMultiplications(32, [&] {
+		check(number::Sum(values.data(), Count) == sum, "tree sum alongside a product");
+		check(number::Product(values.data(), Count) == product, "tree product alongside a product");
+	});
+}
+
+
+
+//-MAIN----------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+	checkBatches();
+	checkTrees();
+
+	if(failures) {
+		std::printf("%zu checks failed\n", failures.load());
+		return 1;
+	}
+
+	std::printf("All checks passed\n");
+	return 0;
+}